@@ -0,0 +1,135 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Settings shared by the benchmark drivers, read from the command line
+ * (see print_benchmark_usage). Drivers ignore the settings that do not
+ * apply to them; the MPI driver, for example, has no engine choice.
+ */
+struct BenchmarkConfig {
+    // Instance files, text or binary
+    std::vector<std::string> datasets;
+
+    // Implementation names as used in the CSV files: sequential,
+    // sequential_<engine>, openmp or openmp_<strategy>
+    std::vector<std::string> engines;
+
+    // Thread counts to run each engine with (empty: the driver's default)
+    std::vector<int> thread_counts;
+
+    // Timed runs per configuration, and untimed runs before them
+    int iterations;
+    int warmup;
+
+    // Directory that receives <implementation>_benchmarks.csv rows
+    // (empty: no CSV output)
+    std::string results_dir;
+
+    // File that receives every configuration as JSON (empty: no JSON)
+    std::string json_file;
+
+    // Keep the engines' progress output during runs
+    bool verbose;
+
+    // Sequential engines: frontier budget in MiB (0: unlimited)
+    double frontier_budget_mb;
+
+    // Reduced-cost variable fixing before the search (every engine)
+    bool fix_variables;
+
+    // OpenMP engines: CSV file for the incumbent trace of the last run
+    // (empty: no trace)
+    std::string trace_file;
+
+    BenchmarkConfig();
+};
+
+/**
+ * Reads the driver options and dataset arguments.
+ *
+ * @param argc, argv Command line of the driver
+ * @param config Output settings; fields not given keep their defaults
+ * @param print_errors Whether to print problems (MPI drivers parse on every
+ *        rank but let only rank 0 report)
+ * @return false (after printing the reason) on a malformed command line
+ */
+bool parse_benchmark_args(int argc, char* argv[], BenchmarkConfig* config,
+                          bool print_errors = true);
+
+// Prints the options parse_benchmark_args understands
+void print_benchmark_usage(const char* program);
+
+// Splits a comma-separated option value, dropping empty entries
+std::vector<std::string> split_list(const char* text);
+
+// Parses a whole argument as an integer >= minimum
+bool parse_count(const char* text, int minimum, int* out);
+
+// Writes text as a JSON string literal, quotes and escapes included
+void write_json_string(std::ostream& out, const std::string& text);
+
+// Spread of the timed runs of one configuration, in seconds
+struct TimingSummary {
+    int runs;
+    double total;
+    double mean;
+    double min;
+    double median;
+    double p95;       // nearest-rank 95th percentile
+    double stddev;    // sample standard deviation (0 for a single run)
+};
+
+// Summarizes a list of run times in seconds
+TimingSummary summarize_timings(const std::vector<double>& seconds);
+
+/**
+ * Measurements of one configuration (dataset, implementation, workers).
+ *
+ * processes is 0 for single-process drivers and threads is 0 for pure MPI;
+ * together they select the CSV layout: a threads column, a processes
+ * column, or both (hybrid).
+ */
+struct BenchmarkResult {
+    std::string dataset;          // file name without directories
+    std::string implementation;
+    int processes;
+    int threads;
+    int warmup;
+    std::vector<double> seconds;  // one entry per timed run
+    TimingSummary timing;
+    long long nodes_explored;     // summed over the timed runs
+    long long nodes_pruned;
+    float optimal_value;
+
+    BenchmarkResult();
+};
+
+// File name of a dataset path, as recorded in the results
+std::string dataset_name(const std::string& path);
+
+// Prints the timing summary of one configuration to stdout
+void print_benchmark_result(const BenchmarkResult& result);
+
+/**
+ * Appends a result to <results_dir>/<implementation>_benchmarks.csv in the
+ * columns the plotting script reads, creating the directory if needed and
+ * writing the header if the file is new or empty.
+ *
+ * @return false (after printing a warning) if the file cannot be written
+ */
+bool append_benchmark_csv(const std::string& results_dir, const BenchmarkResult& result);
+
+/**
+ * Writes all results to a JSON file: an array with one object per
+ * configuration, holding the CSV columns, the timing summary and every
+ * run time.
+ *
+ * @return false (after printing a warning) if the file cannot be written
+ */
+bool write_benchmark_json(const std::string& filename, const std::vector<BenchmarkResult>& results);
+
+#endif // BENCHMARK_HARNESS_H
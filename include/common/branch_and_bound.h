@@ -3,28 +3,45 @@
 
 #include "parser/parser.h"
 #include "tree_node.h"
-
-/**
- * Comparator for priority queue to implement max-heap based on bound values.
- * Nodes with higher bounds are prioritized (best-first search strategy).
- */
-struct CompareNode {
-    bool operator()(TreeNode* a, TreeNode* b) {
-        return a->bound < b->bound; // Returns true if a has lower priority than b
-    }
-};
-
-// Reconstruct solution path from the tree
-void reconstruct_solution(TreeNode* root, TreeNode* best_node, 
-                         Item** best_items, int* best_count);
+#include "search_options.h"
+#include "bound_policy.h"
 
 // Main Branch and Bound algorithm for 0/1 Knapsack
 // Optional output parameters nodes_explored_out and nodes_pruned_out report
-// how many nodes were visited and pruned during the search.
-TreeNode* branch_and_bound(Item* items, int n, float capacity, 
-                          float* max_value, Item** best_items, 
-                          int* best_count,
-                          int* nodes_explored_out = nullptr,
-                          int* nodes_pruned_out = nullptr);
+// how many nodes were visited and pruned during the search; options selects
+// optional behaviour such as a frontier memory budget.
+void branch_and_bound(Item* items, int n, float capacity, 
+                      float* max_value, Item** best_items, 
+                      int* best_count,
+                      int* nodes_explored_out = nullptr,
+                      int* nodes_pruned_out = nullptr,
+                      const SearchOptions* options = nullptr);
+
+// Branch and bound with the upper bound chosen at compile time: DantzigBound
+// (as branch_and_bound), MartelloTothBound or MullerMerbachBound
+template <class Bound>
+void branch_and_bound_with(Item* items, int n, float capacity,
+                           float* max_value, Item** best_items,
+                           int* best_count,
+                           int* nodes_explored_out = nullptr,
+                           int* nodes_pruned_out = nullptr,
+                           const SearchOptions* options = nullptr);
+
+// Branch and bound in fixed-point arithmetic: weights, values and capacity
+// scaled to exact integers, integer bounds rounded down and exact pruning.
+// Falls back to branch_and_bound when the numbers do not scale to integers
+void branch_and_bound_fixed(Item* items, int n, float capacity,
+                            float* max_value, Item** best_items,
+                            int* best_count,
+                            int* nodes_explored_out = nullptr,
+                            int* nodes_pruned_out = nullptr,
+                            const SearchOptions* options = nullptr);
+
+extern template void branch_and_bound_with<DantzigBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
+extern template void branch_and_bound_with<MartelloTothBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
+extern template void branch_and_bound_with<MullerMerbachBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
 
 #endif // BRANCH_AND_BOUND_H
\ No newline at end of file
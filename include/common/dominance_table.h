@@ -0,0 +1,109 @@
+#ifndef DOMINANCE_TABLE_H
+#define DOMINANCE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "tree_node.h"
+
+// Default memory budget of the dominance table of the branch and bound searches
+const size_t DOMINANCE_TABLE_BYTES = 16 << 20;
+
+/**
+ * Fixed-size transposition table of search states for dominance pruning.
+ *
+ * Two nodes at the same level have the same items left to decide, so a node
+ * (w, v) is dominated by an earlier node (w', v') with w' <= w and v' >= v:
+ * every completion of the first is a completion of the second that is at
+ * least as good. The table remembers the states of pushed nodes keyed by
+ * level and weight quantized to capacity / 2^16, and admit() rejects a node
+ * if a state in its own or the next lighter weight bucket dominates it.
+ *
+ * The table is a cache, not a record of every state: a miss only means a
+ * node is searched that could have been dropped. Rejections always compare
+ * exact weights and values, so they never lose an optimal solution.
+ *
+ * Buckets are one cache line of four slots. When a bucket is full the new
+ * state replaces a slot it dominates, otherwise the deepest one, since
+ * shallow states cover the largest subtrees.
+ *
+ * admit() is lock-free and safe to call from any number of threads. Each
+ * slot is a seqlock: readers retry nothing and treat a slot being written
+ * as empty; a writer that finds its slot taken skips the insert. Buckets
+ * are split into shards of equal size, each with its own padded counters.
+ * A state's shard is picked by its hash, not by the calling thread, so any
+ * thread may touch any shard; more shards only spread the counter traffic.
+ */
+class DominanceTable {
+public:
+    /**
+     * @param capacity Knapsack capacity (sets the weight quantum)
+     * @param budget_bytes Memory for the buckets (rounded down to a power of
+     *                     two buckets per shard; 0 disables the table)
+     * @param num_shards Number of hash-selected shards (callers use one per
+     *                   thread to spread contention)
+     */
+    DominanceTable(float capacity, size_t budget_bytes, int num_shards = 1);
+    ~DominanceTable();
+
+    /**
+     * Checks a node against the table and records it if it is not dominated.
+     *
+     * @param node Node about to be pushed
+     * @return false if an earlier state dominates node (drop it)
+     */
+    bool admit(const TreeNode* node) {
+        return admit(node->level, node->t_weight, node->t_value);
+    }
+
+    /**
+     * admit() for a state given by its level and totals, for searches whose
+     * nodes are not TreeNodes.
+     */
+    bool admit(int level, float weight, float value);
+
+    bool enabled() const { return buckets_per_shard_ > 0; }
+
+    // Totals over all shards
+    long long dominated() const;
+    long long evictions() const;
+
+    // Prints size and counters (nothing when disabled)
+    void report() const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> version;  // Odd while being written
+        std::atomic<int32_t> level;     // -1 when empty
+        std::atomic<float> weight;
+        std::atomic<float> value;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[4];
+    };
+
+    struct alignas(64) Shard {
+        Bucket* buckets;
+        std::atomic<long long> dominated;
+        std::atomic<long long> evictions;
+    };
+
+    // Reads a slot; false if it is empty or being written
+    static bool read(const Slot& slot, int* level, float* weight, float* value);
+
+    // Writes a slot unless another thread is writing it
+    static void write(Slot& slot, int level, float weight, float value);
+
+    Bucket& bucket(int level, int64_t quantized, Shard** shard);
+
+    DominanceTable(const DominanceTable&);
+    DominanceTable& operator=(const DominanceTable&);
+
+    Shard* shards_;
+    int num_shards_;
+    size_t buckets_per_shard_;
+    float inverse_quantum_;
+};
+
+#endif // DOMINANCE_TABLE_H
@@ -0,0 +1,48 @@
+#ifndef DYNAMIC_PROGRAMMING_H
+#define DYNAMIC_PROGRAMMING_H
+
+#include <stdint.h>
+#include <vector>
+#include <stddef.h>
+#include "parser/parser.h"
+#include "search_options.h"
+
+// Memory budget of the tables the DP engines allocate over capacity
+// (DP rows, the subset-sum bitset and its first-item array). Instances
+// whose tables would exceed it go to the next engine instead of failing
+// to allocate
+const size_t DP_MAX_BYTES = (size_t)512 << 20;
+
+// Largest items x capacity product the DP engine will take on
+const int64_t DP_MAX_CELLS = (int64_t)1 << 34;
+
+/**
+ * Instance converted to integers for the DP engines: weights, values and
+ * capacity multiplied by a power of ten so that they become exact integers.
+ */
+struct ScaledInstance {
+    int64_t scale;               // Power of ten applied to weights and capacity
+    int64_t value_scale;         // Power of ten applied to values
+    int64_t capacity;            // floor(capacity * scale)
+    std::vector<int32_t> weight; // Scaled weights, in item order
+    std::vector<int32_t> value;  // Scaled values, in item order
+};
+
+// Scales weights/capacity and values by the smallest powers of ten (up to
+// 10^6) that make them integral. Returns false if no such scale exists or
+// the totals would overflow 32 bits.
+bool scale_instance(const Item* items, int n, float capacity, ScaledInstance* out);
+
+// Dense dynamic-programming solver with the same interface as
+// branch_and_bound. Falls back to branch_and_bound when the instance cannot
+// be scaled to integers, its rows exceed DP_MAX_BYTES or capacity x n
+// exceeds DP_MAX_CELLS.
+// options->num_threads sets the OpenMP team used over capacity.
+void dynamic_programming(Item* items, int n, float capacity,
+                         float* max_value, Item** best_items,
+                         int* best_count,
+                         int* nodes_explored_out = nullptr,
+                         int* nodes_pruned_out = nullptr,
+                         const SearchOptions* options = nullptr);
+
+#endif // DYNAMIC_PROGRAMMING_H
@@ -0,0 +1,40 @@
+#ifndef INSTANCE_GENERATOR_H
+#define INSTANCE_GENERATOR_H
+
+#include <vector>
+
+// Distributions generate_items knows, easiest to hardest for pruning:
+//   uncorrelated        - Random values and weights
+//   weakly_correlated   - Value = weight + noise
+//   strongly_correlated - Value = weight + constant
+//   subset_sum          - Value = weight
+//   inverse_strong      - High value = low weight
+const char* const DISTRIBUTIONS[] = {
+    "uncorrelated", "weakly_correlated", "strongly_correlated", "subset_sum", "inverse_strong"
+};
+const int DISTRIBUTION_COUNT = 5;
+
+// Generated items, rounded to the two decimals the text format keeps
+struct Dataset {
+    std::vector<float> values;
+    std::vector<float> weights;
+    float total_weight;   // sum of the weights before rounding
+
+    Dataset() : total_weight(0.0f) {}
+};
+
+/**
+ * Draws num_items items of a distribution with rand(); call srand first
+ * to choose the instance.
+ *
+ * @param num_items Number of items
+ * @param distribution One of DISTRIBUTIONS
+ * @param dataset Output items
+ * @return false for an unknown distribution
+ */
+bool generate_items(int num_items, const char* distribution, Dataset* dataset);
+
+// x as a reader of "%.2f" text gets it back
+float two_decimals(float x);
+
+#endif // INSTANCE_GENERATOR_H
@@ -0,0 +1,48 @@
+#ifndef ITEM_COLUMNS_H
+#define ITEM_COLUMNS_H
+
+#include "parser/parser.h"
+
+// Columns are padded to a multiple of this many floats (one cache line)
+const int ITEM_COLUMN_PAD = 16;
+
+/**
+ * Structure-of-arrays copy of the items for the bound kernels.
+ *
+ * Weight, value and value/weight ratio each live in their own 64-byte
+ * aligned column, so a kernel scanning a range of items streams exactly
+ * the fields it needs and vector loads never straddle an Item. Ratios are
+ * computed once here instead of on every comparison or bound. Ids are
+ * stored apart from the hot columns; only to_items() reads them.
+ *
+ * Columns are zero-padded up to a multiple of ITEM_COLUMN_PAD; the padding
+ * is not part of the instance.
+ */
+class ItemColumns {
+public:
+    // Copies the items in their current order
+    ItemColumns(const Item* items, int n);
+    ~ItemColumns();
+
+    int size() const { return n_; }
+
+    const float* weight() const { return weight_; }
+    const float* value() const { return value_; }
+    const float* ratio() const { return ratio_; }
+    const int* id() const { return id_; }
+
+    // Writes the items back as an Item array (out has room for size() items)
+    void to_items(Item* out) const;
+
+private:
+    ItemColumns(const ItemColumns&);
+    ItemColumns& operator=(const ItemColumns&);
+
+    int n_;
+    float* weight_;
+    float* value_;
+    float* ratio_;
+    int* id_;
+};
+
+#endif // ITEM_COLUMNS_H
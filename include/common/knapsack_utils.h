@@ -7,7 +7,23 @@
 // Comparator to sort items by value-to-weight ratio in descending order
 bool compare_items(const Item& a, const Item& b);
 
+// Sorts items into compare_items order, computing each ratio only once
+void sort_items(Item* items, int n);
+
+// Relative slack under which a bound counts as equal to the incumbent.
+// Float sums of the same items differ by a few ulps depending on the order
+// they are added in, which is far below any real improvement in value.
+const float BOUND_TOLERANCE = 1e-6f;
+
+// Whether a node with this upper bound could still beat the incumbent
+inline bool can_improve(float bound, float incumbent) {
+    return bound > incumbent + incumbent * BOUND_TOLERANCE;
+}
+
 // Calculate upper bound on value for a node
 float calculate_bound(TreeNode* node, Item* items, int n, float capacity);
 
+// Copy the items selected by a packed decision bitset into out; returns count
+int collect_solution(const uint64_t* decisions, const Item* items, int n, Item* out);
+
 #endif // KNAPSACK_UTILS_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef MEET_IN_THE_MIDDLE_H
+#define MEET_IN_THE_MIDDLE_H
+
+#include "parser/parser.h"
+#include "search_options.h"
+
+// Largest instance solved with two full half-lists (Horowitz-Sahni); each
+// half holds up to 2^(n/2) subsets
+const int MITM_HALF_MAX_ITEMS = 32;
+
+// Largest instance the engine takes on at all. Above MITM_HALF_MAX_ITEMS it
+// streams the half-lists from quarter lists (Schroeppel-Shamir), which
+// keeps memory at O(2^(n/4)); time is O(2^(n/2)) in the worst case, cut
+// down by bound and dominance pruning of the streams
+const int MITM_MAX_ITEMS = 80;
+
+// Meet-in-the-middle solver with the same interface as branch_and_bound.
+// Instances with more than MITM_MAX_ITEMS items are handed to
+// branch_and_bound. options->num_threads sets the OpenMP team used to build
+// and sort the subset lists. nodes_explored_out reports the subset sums
+// combined.
+void meet_in_the_middle(Item* items, int n, float capacity,
+                        float* max_value, Item** best_items,
+                        int* best_count,
+                        int* nodes_explored_out = nullptr,
+                        int* nodes_pruned_out = nullptr,
+                        const SearchOptions* options = nullptr);
+
+#endif // MEET_IN_THE_MIDDLE_H
@@ -0,0 +1,109 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <stddef.h>
+
+/**
+ * Slab allocator for search tree nodes.
+ *
+ * Nodes are carved out of large mmap'd slabs instead of going through
+ * operator new, so an expansion costs a pointer bump and tearing down a
+ * whole search is a handful of slab resets instead of millions of frees.
+ *
+ * The arena is split into independent pools, one per worker thread. A pool
+ * is only ever touched by its owning thread, so allocation never takes a
+ * lock and never touches the global heap (slabs are mapped directly from
+ * the OS). Each pool keeps its slabs on an intrusive list so the arena can
+ * be rewound with reset() and reused by the next search without remapping.
+ *
+ * The arena is type-agnostic: it hands out fixed-size, 16-byte aligned
+ * blocks of node_bytes each. Callers placement-new their node type into them
+ * (see TreeNode::add). Destructors are never run.
+ */
+class NodeArena {
+public:
+    /**
+     * @param num_pools Number of independent pools (one per thread)
+     * @param node_bytes Size of every block handed out by allocate()
+     * @param use_huge_pages Back slabs with huge pages when the OS allows it
+     */
+    explicit NodeArena(int num_pools = 1, size_t node_bytes = 64,
+                       bool use_huge_pages = false);
+    ~NodeArena();
+
+    // Returns an uninitialized block from the given pool.
+    void* allocate(int pool = 0) {
+        Pool& p = pools_[pool];
+        if (p.free_list) {
+            FreeBlock* block = p.free_list;
+            p.free_list = block->next;
+            return block;
+        }
+        if ((size_t)(p.limit - p.cursor) < node_bytes_) {
+            next_slab(p);
+        }
+        void* block = p.cursor;
+        p.cursor += node_bytes_;
+        p.allocated++;
+        return block;
+    }
+
+    // Returns a block to the pool of the calling thread for reuse.
+    // The block may have been allocated from any pool of this arena.
+    void recycle(void* block, int pool = 0) {
+        Pool& p = pools_[pool];
+        FreeBlock* free_block = static_cast<FreeBlock*>(block);
+        free_block->next = p.free_list;
+        p.free_list = free_block;
+    }
+
+    // Forgets every block in every pool. Slabs stay mapped for reuse.
+    void reset();
+
+    // Unmaps every slab in every pool.
+    void release();
+
+    // Total number of fresh blocks carved from slabs since the last reset.
+    size_t nodes_allocated() const;
+
+    // Bytes currently mapped across all pools.
+    size_t bytes_mapped() const;
+
+    size_t node_bytes() const { return node_bytes_; }
+    int num_pools() const { return num_pools_; }
+
+private:
+    struct Slab {
+        Slab* next;
+        size_t bytes;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Padded to a cache line so neighbouring threads never share one.
+    struct alignas(64) Pool {
+        Slab* head;         // First slab mapped by this pool
+        Slab* current;      // Slab currently being carved
+        char* cursor;       // Next free byte in current slab
+        char* limit;        // End of current slab
+        FreeBlock* free_list;
+        size_t allocated;
+    };
+
+    void next_slab(Pool& p);
+    Slab* map_slab();
+    static char* slab_data(Slab* slab);
+
+    NodeArena(const NodeArena&);
+    NodeArena& operator=(const NodeArena&);
+
+    Pool* pools_;
+    int num_pools_;
+    size_t node_bytes_;
+    size_t slab_bytes_;
+    bool use_huge_pages_;
+};
+
+#endif // NODE_ARENA_H
@@ -0,0 +1,32 @@
+#ifndef NODE_CODEC_H
+#define NODE_CODEC_H
+
+#include <vector>
+#include <stdint.h>
+#include "parser/parser.h"
+#include "tree_node.h"
+#include "prefix_bound.h"
+
+/**
+ * Compact wire format for shipping open nodes between processes.
+ *
+ * A node is sent as its level followed by its decision bits, one record of
+ * node_record_words(words) 64-bit words. Weight, value and bound are not
+ * sent: the receiver recomputes them from the bits and its own copy of the
+ * sorted items, so a record is a few words instead of a full TreeNode.
+ */
+
+// Words per encoded node: one for the level, then the decision bitset
+inline int node_record_words(int words) {
+    return 1 + words;
+}
+
+// Append node's record (level + decision bits) to buffer
+void encode_node(const TreeNode* node, int words, std::vector<uint64_t>& buffer);
+
+// Rebuild a node from its record: sums the included items and recomputes
+// the bound. The node is allocated from arena's pool.
+TreeNode* decode_node(const uint64_t* record, const Item* items, int n,
+                      const PrefixBound& bounds, NodeArena& arena, int pool);
+
+#endif // NODE_CODEC_H
@@ -7,4 +7,14 @@
 void print_sorted_items(Item* items, int n);
 void print_statistics(int nodes_explored, int nodes_pruned);
 
+// Turns the engines' progress output (sorted items, statistics and the
+// print_info lines) on or off. On by default; benchmark drivers switch it
+// off so timed runs do no console I/O.
+void set_search_output(bool enabled);
+bool search_output();
+
+// printf for engine progress messages; prints nothing while search output
+// is off. Errors and warnings keep using printf.
+void print_info(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
 #endif // OUTPUT_DISPLAY_H
\ No newline at end of file
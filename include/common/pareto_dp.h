@@ -0,0 +1,22 @@
+#ifndef PARETO_DP_H
+#define PARETO_DP_H
+
+#include "parser/parser.h"
+#include "search_options.h"
+
+// Largest number of live Pareto states before the engine gives up and hands
+// the instance to branch_and_bound
+const int PARETO_MAX_STATES = 1 << 25;
+
+// Sparse dynamic-programming solver (Nemhauser-Ullmann) with the same
+// interface as branch_and_bound. Works directly on float weights and
+// capacities of any size. nodes_explored_out reports the states generated
+// and nodes_pruned_out those discarded by the fractional bound.
+void pareto_dp(Item* items, int n, float capacity,
+               float* max_value, Item** best_items,
+               int* best_count,
+               int* nodes_explored_out = nullptr,
+               int* nodes_pruned_out = nullptr,
+               const SearchOptions* options = nullptr);
+
+#endif // PARETO_DP_H
@@ -0,0 +1,93 @@
+#ifndef INSTANCE_FILE_H
+#define INSTANCE_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Current version of the binary instance format
+const uint32_t INSTANCE_FILE_VERSION = 1;
+
+// Alignment of the header and of every column in the file
+const size_t INSTANCE_FILE_ALIGN = 64;
+
+/**
+ * Header of a binary instance file, at offset 0.
+ *
+ * The file is the header followed by three columns of item_count entries:
+ * weight (float), value (float) and id (int32_t), each starting at its
+ * recorded offset, a multiple of INSTANCE_FILE_ALIGN. Numbers are stored
+ * in the byte order of the machine that wrote the file; byte_order tells
+ * readers whether it matches theirs.
+ */
+struct InstanceFileHeader {
+    char magic[8];            // "KNAPBIN\0"
+    uint32_t version;         // INSTANCE_FILE_VERSION
+    uint32_t byte_order;      // 0x01020304 as written
+    int64_t item_count;
+    float capacity;
+    uint32_t reserved;
+    uint64_t weight_offset;
+    uint64_t value_offset;
+    uint64_t id_offset;
+    uint8_t padding[8];
+};
+
+/**
+ * Read-only memory mapping of a binary instance file.
+ *
+ * weight(), value() and id() point into the mapping, 64-byte aligned, and
+ * hold the numbers as stored, so nothing is parsed. The solvers sort and
+ * own their items, so read_items copies the columns into an Item array and
+ * releases the mapping; every process, MPI ranks included, keeps its own
+ * copy.
+ */
+class MappedInstance {
+public:
+    MappedInstance();
+    ~MappedInstance();
+
+    /**
+     * Maps and validates a file. Prints the reason and returns false if it
+     * is not a readable binary instance.
+     */
+    bool open(const char* filename);
+
+    int size() const { return (int)header_->item_count; }
+    float capacity() const { return header_->capacity; }
+
+    const float* weight() const { return column<float>(header_->weight_offset); }
+    const float* value() const { return column<float>(header_->value_offset); }
+    const int32_t* id() const { return column<int32_t>(header_->id_offset); }
+
+private:
+    template <typename T>
+    const T* column(uint64_t offset) const {
+        return reinterpret_cast<const T*>(static_cast<const char*>(base_) + offset);
+    }
+
+    void close();
+
+    MappedInstance(const MappedInstance&);
+    MappedInstance& operator=(const MappedInstance&);
+
+    void* base_;
+    size_t bytes_;
+    const InstanceFileHeader* header_;
+};
+
+// Whether a file starts with the binary instance magic
+bool is_instance_file(const char* filename);
+
+/**
+ * Writes a binary instance file from item columns.
+ *
+ * @param filename Path of the file to create
+ * @param weight, value, id Item columns of n entries
+ * @param n Number of items
+ * @param capacity Knapsack capacity
+ * @return false (after printing the reason) if the file could not be written
+ */
+bool write_instance_file(const char* filename, const float* weight, const float* value,
+                         const int32_t* id, int n, float capacity);
+
+#endif // INSTANCE_FILE_H
@@ -0,0 +1,73 @@
+#ifndef PREFIX_BOUND_H
+#define PREFIX_BOUND_H
+
+#include <vector>
+#include "item_columns.h"
+#include "parser/parser.h"
+#include "tree_node.h"
+
+/**
+ * Fractional (Dantzig) upper bound evaluated in O(log n) instead of O(n).
+ *
+ * Prefix sums of weight and value are precomputed once over the items in
+ * ratio order, so the greedy fill from any level is a range sum and the
+ * critical item (first item that no longer fits whole) is a search over the
+ * weight prefix array.
+ *
+ * Each node remembers its critical index. A child's critical index is never
+ * before its parent's, so the search gallops forward from the parent's index:
+ * an include child lands on the same index in O(1), an exclude child only
+ * moves as far as the capacity it freed.
+ *
+ * Produces the same bound as calculate_bound, which remains the reference
+ * implementation. The items are kept as ItemColumns for the bound policies
+ * that scan them.
+ */
+class PrefixBound {
+public:
+    /**
+     * Greedy fill of the free items below a node: items [first, critical)
+     * fit whole, item `critical` is the first that does not (n if all fit).
+     */
+    struct Fill {
+        int first;        // First free item (level + 1)
+        int critical;     // Critical item index
+        double value;     // Node value plus the whole items taken
+        double residual;  // Capacity left after the whole items
+    };
+
+    // Items must already be sorted by compare_items
+    PrefixBound(const Item* items, int n, float capacity);
+
+    /**
+     * Upper bound for a node. Reads node->critical as a search hint and
+     * stores the node's own critical index back into it.
+     */
+    float bound(TreeNode* node) const;
+
+    // Upper bound for a partial solution given explicitly
+    float bound(int level, float t_weight, float t_value, int* critical) const;
+
+    // Greedy fill for a partial solution (t_weight must be below capacity).
+    // critical is a search hint in and the critical index out, as for bound
+    Fill fill(int level, float t_weight, float t_value, int* critical) const;
+
+    // Value/weight ratio of item j
+    float ratio(int j) const { return columns_.ratio()[j]; }
+
+    const ItemColumns& columns() const { return columns_; }
+
+    int size() const { return n_; }
+    float capacity() const { return capacity_; }
+
+private:
+    int find_critical(int first, double target, int hint) const;
+
+    int n_;
+    float capacity_;
+    std::vector<double> prefix_weight_;  // prefix_weight_[j] = sum of weights 0..j-1
+    std::vector<double> prefix_value_;   // prefix_value_[j] = sum of values 0..j-1
+    ItemColumns columns_;
+};
+
+#endif // PREFIX_BOUND_H
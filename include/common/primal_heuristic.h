@@ -0,0 +1,29 @@
+#ifndef PRIMAL_HEURISTIC_H
+#define PRIMAL_HEURISTIC_H
+
+#include <stdint.h>
+#include <vector>
+#include "parser/parser.h"
+
+// Items on each side of the critical item that the exchange search tries
+const int HEURISTIC_CORE = 32;
+
+/**
+ * Feasible solution found before the search, in the same form as a search
+ * incumbent: value, weight and packed decision bits over the sorted items.
+ */
+struct HeuristicSolution {
+    float value;
+    float weight;
+    std::vector<uint64_t> decisions;  // TreeNode::decision_words(n) words
+};
+
+// Builds a strong incumbent: greedy fill, greedy or best single item, then
+// 1-swap (add) / 2-swap (exchange) local search. Items must be sorted by
+// compare_items. Seed 0 starts from the plain greedy order; other seeds
+// start from a randomly perturbed order, so different callers (e.g. MPI
+// ranks) explore different neighbourhoods.
+void primal_heuristic(const Item* items, int n, float capacity,
+                      unsigned int seed, HeuristicSolution* out);
+
+#endif // PRIMAL_HEURISTIC_H
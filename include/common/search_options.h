@@ -0,0 +1,36 @@
+#ifndef SEARCH_OPTIONS_H
+#define SEARCH_OPTIONS_H
+
+#include <stddef.h>
+#include "dominance_table.h"
+
+/**
+ * Optional tuning knobs for the branch and bound search.
+ * A default-constructed SearchOptions (or passing nullptr) gives the
+ * classic unbounded best-first search.
+ */
+struct SearchOptions {
+    // Memory budget in bytes for the open frontier (nodes and queue slots).
+    // While the frontier fits, the search is best-first; once it is full,
+    // the best open node is searched depth-first instead of being expanded
+    // into the queue. 0 means unlimited.
+    size_t frontier_budget_bytes;
+
+    // Threads for engines that parallelize internally (e.g. the DP engine
+    // over capacity). 0 means the OpenMP default.
+    int num_threads;
+
+    // Fix variables by LP reduced costs before the search, so the engine
+    // only branches over items not already proven in or out (run_solver)
+    bool fix_variables;
+
+    // Memory for the table of (level, weight, value) states used to drop
+    // nodes dominated by an earlier node at the same level. 0 disables it.
+    size_t dominance_table_bytes;
+
+    SearchOptions()
+        : frontier_budget_bytes(0), num_threads(0), fix_variables(true),
+          dominance_table_bytes(DOMINANCE_TABLE_BYTES) {}
+};
+
+#endif // SEARCH_OPTIONS_H
@@ -0,0 +1,124 @@
+#ifndef SEARCH_TELEMETRY_H
+#define SEARCH_TELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Counters of one search thread. Each thread writes only its own, which
+ * fills whole cache lines, so counting never moves a line between cores;
+ * the counters are merged after the search.
+ */
+struct alignas(64) ThreadTelemetry {
+    long long expanded;          // Nodes taken off the queue
+    long long pruned_bound;      // Taken off, but no longer beat the incumbent
+    long long pruned_children;   // Children discarded by bound when created
+    long long dominated;         // Children rejected by the dominance table
+    long long leaves;            // Nodes with every item decided
+    long long steals;            // Nodes taken from another thread's queue
+    long long failed_steals;     // Victims found empty
+    long long queue_high_water;  // Most nodes seen in the thread's queue
+    double idle_seconds;         // Time spent without a node to expand
+};
+
+// Incumbent trace events
+enum TraceEvent {
+    TRACE_START,        // Search start: heuristic incumbent and root bound
+    TRACE_IMPROVEMENT,  // A thread raised the incumbent (no bound)
+    TRACE_SAMPLE,       // Periodic sample of the best open bound
+    TRACE_FINISH        // Search complete: the incumbent is optimal
+};
+
+// A thread looks at the clock every TRACE_SAMPLE_EXPANSIONS of its own
+// expansions, and the open bound is sampled at most every
+// TRACE_SAMPLE_SECONDS
+const long long TRACE_SAMPLE_EXPANSIONS = 1024;
+const double TRACE_SAMPLE_SECONDS = 0.01;
+
+/**
+ * Per-thread counters of a parallel search, and an optional timeline of the
+ * incumbent: every improvement with its time and thread, interleaved with
+ * periodic samples of the best bound still open, so time to a good
+ * solution and the closing gap can be plotted. The timeline is kept only
+ * while search_trace_file() is set.
+ */
+class SearchTelemetry {
+public:
+    explicit SearchTelemetry(int num_threads);
+    ~SearchTelemetry();
+
+    ThreadTelemetry& thread(int id) { return threads_[id]; }
+    const ThreadTelemetry& thread(int id) const { return threads_[id]; }
+    int num_threads() const { return num_threads_; }
+
+    // Sum of the thread counters (maximum for queue_high_water)
+    ThreadTelemetry total() const;
+
+    // Seconds since construction
+    double elapsed() const;
+
+    bool tracing() const { return tracing_; }
+
+    /**
+     * Whether the calling thread should sample the open bound now. Only
+     * every TRACE_SAMPLE_EXPANSIONS-th expansion of a thread reads the
+     * clock, and at most one thread wins each TRACE_SAMPLE_SECONDS period.
+     *
+     * @param expanded Expansions of the calling thread so far
+     */
+    bool claim_sample(long long expanded) {
+        return tracing_ && expanded % TRACE_SAMPLE_EXPANSIONS == 0 && claim_sample_slow();
+    }
+
+    /**
+     * Appends a trace point (no-op unless tracing). Not thread-safe: the
+     * caller serializes, e.g. under the incumbent lock.
+     *
+     * @param event What happened
+     * @param thread Thread that caused it (-1 for none)
+     * @param incumbent Incumbent value afterwards
+     * @param open_bound Best bound of the queued nodes; negative when not
+     *                   sampled, none are queued or the strategy cannot see
+     *                   its queue
+     */
+    void record(TraceEvent event, int thread, float incumbent, float open_bound);
+
+    // Prints one line per thread and the totals
+    void report() const;
+
+    // Writes the trace to search_trace_file() if tracing
+    bool write_trace() const;
+
+private:
+    struct TracePoint {
+        double seconds;
+        TraceEvent event;
+        int thread;
+        float incumbent;
+        float open_bound;
+    };
+
+    bool claim_sample_slow();
+
+    SearchTelemetry(const SearchTelemetry&);
+    SearchTelemetry& operator=(const SearchTelemetry&);
+
+    ThreadTelemetry* threads_;
+    int num_threads_;
+    std::chrono::steady_clock::time_point start_;
+    bool tracing_;
+    std::vector<TracePoint> trace_;
+    std::atomic<double> next_sample_;  // Seconds at which the next sample is due
+};
+
+/**
+ * Sets the CSV file the parallel searches write their incumbent trace to
+ * (empty to disable tracing, the default). The file is rewritten by every
+ * search, so it holds the trace of the last one.
+ */
+void set_search_trace_file(const std::string& path);
+const std::string& search_trace_file();
+
+#endif // SEARCH_TELEMETRY_H
@@ -0,0 +1,31 @@
+#ifndef SOLVERS_H
+#define SOLVERS_H
+
+#include "parser/parser.h"
+#include "search_options.h"
+
+// Signature shared by the sequential engines (branch_and_bound and the
+// engines that can be called in its place)
+typedef void (*Solver)(Item* items, int n, float capacity,
+                       float* max_value, Item** best_items,
+                       int* best_count,
+                       int* nodes_explored_out, int* nodes_pruned_out,
+                       const SearchOptions* options);
+
+// Looks up an engine by name: "bnb" (branch and bound with the Dantzig
+// bound), "bnb_mt2" / "bnb_mm" (Martello-Toth U2 / Mueller-Merbach bounds),
+// "bnb_fixed" (fixed-point branch and bound), "dp", "subset", "pareto" or
+// "mitm".
+// Returns nullptr for an unknown name.
+Solver solver_for(const char* engine);
+
+// Runs an engine on the problem. With options->fix_variables, reduced-cost
+// preprocessing runs first and the engine only sees the items left free;
+// the returned solution is mapped back to the full item set.
+void run_solver(Solver solver, Item* items, int n, float capacity,
+                float* max_value, Item** best_items,
+                int* best_count,
+                int* nodes_explored_out, int* nodes_pruned_out,
+                const SearchOptions* options);
+
+#endif // SOLVERS_H
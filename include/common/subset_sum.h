@@ -0,0 +1,23 @@
+#ifndef SUBSET_SUM_H
+#define SUBSET_SUM_H
+
+#include "parser/parser.h"
+#include "search_options.h"
+
+// Returns true if every item's value equals its weight, so maximizing value
+// is maximizing the packed weight (a subset-sum instance)
+bool is_subset_sum(const Item* items, int n);
+
+// Subset-sum solver with the same interface as branch_and_bound. Finds all
+// reachable sums with a shift-or bitset, then recovers one subset for the
+// largest sum that fits. Falls back to dynamic_programming when values differ
+// from weights, the weights cannot be scaled to integers or the tables would
+// exceed DP_MAX_BYTES.
+void subset_sum(Item* items, int n, float capacity,
+                float* max_value, Item** best_items,
+                int* best_count,
+                int* nodes_explored_out = nullptr,
+                int* nodes_pruned_out = nullptr,
+                const SearchOptions* options = nullptr);
+
+#endif // SUBSET_SUM_H
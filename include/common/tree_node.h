@@ -1,68 +1,111 @@
 #ifndef TREE_NODE_H
 #define TREE_NODE_H
 
+#include <new>
+#include <stdint.h>
+#include <string.h>
 #include "parser/parser.h"
+#include "node_arena.h"
 
 /**
  * TreeNode represents a state in the branch and bound search tree.
  * Each node corresponds to a decision point: include or exclude an item.
- * The tree structure allows exploration of all possible item combinations.
+ *
+ * The tree is implicit: nodes hold no parent or child pointers. Instead every
+ * node carries its full decision path as a packed bitset (bit i set means
+ * sorted item i is in the knapsack), stored in the same arena block right
+ * after the node. A node therefore describes its own partial solution, the
+ * incumbent's items can be read straight off its bits, and a node can be
+ * recycled as soon as it has been pruned or expanded.
  */
-class TreeNode {
+class alignas(8) TreeNode {
 public:
-    Item item;              // Current item being considered at this node
     float t_weight;         // Total weight of items selected so far
     float t_value;          // Total value of items selected so far
     float bound;            // Upper bound on achievable value from this node
     int level;              // Depth in decision tree (item index)
-    TreeNode* left;         // Left child: include current item
-    TreeNode* right;        // Right child: exclude current item
-    bool included;          // Whether this node represents an inclusion decision
-    
-    TreeNode() {
-        item.id = 0;
-        item.value = 0.0f;
-        item.weight = 0.0f;
-        t_weight = 0.0f;
-        t_value = 0.0f;
-        bound = 0.0f;
-        level = -1;
-        left = nullptr;
-        right = nullptr;
-        included = false;
+    int critical;           // First item the bound could not take whole
+
+    // Number of 64-bit words needed to hold one decision bit per item
+    static int decision_words(int n) {
+        return (n + 63) / 64;
+    }
+
+    // Arena block size for a node over n items (node plus its bitset)
+    static size_t bytes_for(int n) {
+        return sizeof(TreeNode) + decision_words(n) * sizeof(uint64_t);
+    }
+
+    // Packed include bits, one per sorted item, following the node
+    uint64_t* decisions() {
+        return reinterpret_cast<uint64_t*>(this + 1);
     }
-    
+
+    const uint64_t* decisions() const {
+        return reinterpret_cast<const uint64_t*>(this + 1);
+    }
+
+    // Whether sorted item `index` was included on the path to this node
+    bool is_included(int index) const {
+        return (decisions()[index >> 6] >> (index & 63)) & 1u;
+    }
+
     /**
-     * Creates and attaches a child node to this node.
-     * 
-     * @param isleft True for left child (include item), false for right (exclude item)
-     * @param item_to_add The item being considered at the new node
+     * Creates a root node (empty knapsack, no decisions made).
+     *
+     * @param arena Arena the node is allocated from
+     * @param pool Arena pool of the calling thread
+     * @param words Decision words per node (decision_words(n))
+     * @return Pointer to the new root
+     */
+    static TreeNode* create_root(NodeArena& arena, int pool, int words) {
+        TreeNode* node = new (arena.allocate(pool)) TreeNode();
+        node->t_weight = 0.0f;
+        node->t_value = 0.0f;
+        node->bound = 0.0f;
+        node->level = -1;
+        node->critical = 0;
+        memset(node->decisions(), 0, words * sizeof(uint64_t));
+        return node;
+    }
+
+    /**
+     * Creates a child node deciding item level + 1.
+     * The child inherits this node's decision bits; the parent can be
+     * recycled independently afterwards.
+     *
+     * @param arena Arena the new node is allocated from
+     * @param pool Arena pool of the calling thread
+     * @param words Decision words per node (decision_words(n))
+     * @param include True to include item level + 1, false to exclude it
      * @param new_t_weight Accumulated weight at the new node
      * @param new_t_value Accumulated value at the new node
-     * @param new_level Depth level of the new node
      * @return Pointer to the newly created child node
      */
-    TreeNode* add(bool isleft, Item item_to_add, float new_t_weight, float new_t_value, int new_level) {
-        TreeNode* node = new TreeNode();
-        node->item = item_to_add;
+    TreeNode* add(NodeArena& arena, int pool, int words, bool include,
+                  float new_t_weight, float new_t_value) const {
+        TreeNode* node = new (arena.allocate(pool)) TreeNode();
         node->t_weight = new_t_weight;
         node->t_value = new_t_value;
-        node->level = new_level;
-        node->included = isleft;
-        
-        if (isleft) {
-            left = node;
-        } else {
-            right = node;
+        node->bound = 0.0f;
+        node->level = level + 1;
+        node->critical = critical;  // Search hint for the child's bound
+        memcpy(node->decisions(), decisions(), words * sizeof(uint64_t));
+        if (include) {
+            node->decisions()[node->level >> 6] |= uint64_t(1) << (node->level & 63);
         }
-        
         return node;
     }
-    
-    ~TreeNode() {
-        if (left) delete left;
-        if (right) delete right;
+};
+
+/**
+ * Comparator for priority queue to implement max-heap based on bound values.
+ * Nodes with higher bounds are prioritized (best-first search strategy).
+ */
+struct CompareNode {
+    bool operator()(TreeNode* a, TreeNode* b) {
+        return a->bound < b->bound; // Returns true if a has lower priority than b
     }
 };
 
-#endif // TREE_NODE_H
\ No newline at end of file
+#endif // TREE_NODE_H
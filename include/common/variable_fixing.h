@@ -0,0 +1,74 @@
+#ifndef VARIABLE_FIXING_H
+#define VARIABLE_FIXING_H
+
+#include <vector>
+#include "parser/parser.h"
+
+/**
+ * Result of reduced-cost preprocessing: the items proven to be in or out of
+ * every optimal solution, and the smaller problem left over the rest.
+ */
+struct ReducedProblem {
+    std::vector<Item> free_items;  // Items still to be decided, in ratio order
+    float capacity;                // Capacity left after the fixed-in items
+    std::vector<Item> fixed_in;    // Items in every optimal solution
+    int fixed_out;                 // Number of items in no optimal solution
+    float fixed_value;             // Total value of fixed_in
+    float lower_bound;             // Heuristic incumbent used for fixing
+    float upper_bound;             // LP (Dantzig) bound of the full problem
+};
+
+// Fixes variables with Dembo-Hammer reduced costs and reports how many
+// were fixed. Sorts items by ratio in place; the free items keep their
+// original IDs.
+void fix_variables(Item* items, int n, float capacity, ReducedProblem* out);
+
+// Combines the solution of the reduced problem with the fixed-in items into
+// a solution of the original problem (best_items is allocated with new[]).
+void expand_solution(const ReducedProblem& reduced,
+                     float reduced_value, const Item* reduced_items,
+                     int reduced_count, int n,
+                     float* max_value, Item** best_items, int* best_count);
+
+/**
+ * Solves the free items of a reduced problem and maps the solution back to
+ * the n items of the original one (see expand_solution). search is called
+ * as search(items, count, capacity, &value, &best_items, &best_count) on
+ * the free items and residual capacity, and not at all when none are left
+ * free. Outputs may be nullptr.
+ */
+template <class Search>
+void solve_reduced(ReducedProblem* reduced, int n, float* max_value,
+                   Item** best_items, int* best_count, Search search) {
+    float reduced_value = 0.0f;
+    Item* reduced_items = nullptr;
+    int reduced_count = 0;
+    int free_count = (int)reduced->free_items.size();
+    if (free_count > 0) {
+        search(reduced->free_items.data(), free_count, reduced->capacity,
+               &reduced_value, &reduced_items, &reduced_count);
+    }
+
+    float value = 0.0f;
+    Item* solution = nullptr;
+    int count = 0;
+    expand_solution(*reduced, reduced_value, reduced_items, reduced_count, n,
+                    &value, &solution, &count);
+    delete[] reduced_items;
+    if (max_value) *max_value = value;
+    if (best_count) *best_count = count;
+    if (best_items) {
+        *best_items = solution;
+    } else {
+        delete[] solution;
+    }
+}
+
+/**
+ * Turns variable fixing on (the default) or off for the engines that take
+ * no SearchOptions: the OpenMP strategies and the MPI and hybrid searches.
+ */
+void set_variable_fixing(bool enabled);
+bool variable_fixing();
+
+#endif // VARIABLE_FIXING_H
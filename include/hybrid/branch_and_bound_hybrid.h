@@ -0,0 +1,27 @@
+#ifndef BRANCH_AND_BOUND_HYBRID_H
+#define BRANCH_AND_BOUND_HYBRID_H
+
+#include <mpi.h>
+#include "parser/parser.h"
+#include "branch_and_bound_mpi.h"
+
+// Hybrid MPI + OpenMP Branch and Bound for 0/1 Knapsack: one MPI rank per
+// node hands out subtrees, and a team of num_threads OpenMP threads inside
+// each rank searches them. Requires MPI_THREAD_SERIALIZED or better;
+// otherwise each rank falls back to a single thread.
+void branch_and_bound_hybrid(Item* items,
+                             int item_count,
+                             float capacity,
+                             int num_threads,
+                             float* global_best_value,
+                             Item** best_items,
+                             int* best_count,
+                             MpiStats* stats,
+                             MPI_Comm comm);
+
+// Reads the instance on rank 0 and broadcasts it, so only one process per
+// job touches the file. Returns nullptr on every rank if reading failed.
+Item* read_items_shared(const char* filename, int* item_count, float* capacity,
+                        MPI_Comm comm);
+
+#endif // BRANCH_AND_BOUND_HYBRID_H
@@ -0,0 +1,4 @@
+#ifndef TEST_CONFIG_H
+#define TEST_CONFIG_H
+#define TEST_FILE "data/140_subset_sum.txt"
+#endif
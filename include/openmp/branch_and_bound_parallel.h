@@ -5,28 +5,46 @@
 #include "parser/parser.h"
 #include "tree_node.h"
 
-/**
- * Comparator for priority queue to implement max-heap based on bound values.
- * Nodes with higher bounds are prioritized (best-first search strategy).
- */
-struct CompareNode {
-    bool operator()(TreeNode* a, TreeNode* b) {
-        return a->bound < b->bound; // Returns true if a has lower priority than b
-    }
-};
-
-// Reconstruct solution path from the tree
-void reconstruct_solution(TreeNode* root, TreeNode* best_node, 
-                         Item** best_items, int* best_count);
-
 // Main OpenMP Parallel Branch and Bound algorithm for 0/1 Knapsack.
 // Optional output parameters nodes_explored_out and nodes_pruned_out report
 // how many nodes were visited and pruned during the search.
-TreeNode* branch_and_bound_parallel(Item* items, int n, float capacity, 
-                                   float* max_value, Item** best_items, 
-                                   int* best_count, int num_threads,
-                                   int* nodes_explored_out = nullptr,
-                                   int* nodes_pruned_out = nullptr);
+void branch_and_bound_parallel(Item* items, int n, float capacity, 
+                               float* max_value, Item** best_items, 
+                               int* best_count, int num_threads,
+                               int* nodes_explored_out = nullptr,
+                               int* nodes_pruned_out = nullptr);
+
+// Task-parallel variant: spawns one OpenMP task per promising node down to a
+// cutoff depth, then searches each subtree sequentially inside its task.
+// Same parameters and outputs as branch_and_bound_parallel.
+void branch_and_bound_tasks(Item* items, int n, float capacity,
+                            float* max_value, Item** best_items,
+                            int* best_count, int num_threads,
+                            int* nodes_explored_out = nullptr,
+                            int* nodes_pruned_out = nullptr);
+
+// Shared best-first variant: all threads pop from one relaxed concurrent
+// priority queue (MultiQueue). Same parameters and outputs as
+// branch_and_bound_parallel.
+void branch_and_bound_multiqueue(Item* items, int n, float capacity,
+                                 float* max_value, Item** best_items,
+                                 int* best_count, int num_threads,
+                                 int* nodes_explored_out = nullptr,
+                                 int* nodes_pruned_out = nullptr);
+
+// Signature shared by the OpenMP search strategies
+typedef void (*ParallelSolver)(Item* items, int n, float capacity,
+                               float* max_value, Item** best_items,
+                               int* best_count, int num_threads,
+                               int* nodes_explored_out, int* nodes_pruned_out);
+
+// Looks up a strategy by name ("steal", "tasks" or "multiqueue").
+// Returns nullptr for an unknown name.
+ParallelSolver parallel_solver_for(const char* strategy);
+
+// Depth at which branch_and_bound_tasks stops spawning tasks, chosen from
+// the item count, thread count and the gap between root bound and greedy value
+int choose_task_cutoff(int n, int num_threads, float root_bound, float greedy);
 
 #endif // BRANCH_AND_BOUND_PARALLEL_H
 
@@ -0,0 +1,146 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <omp.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "tree_node.h"
+
+/**
+ * Relaxed concurrent priority queue (MultiQueue) of open nodes, shared by
+ * all threads for best-first search.
+ *
+ * The frontier is split over several locked max-heaps ordered by bound,
+ * a few per thread. A push goes to a random heap. A pop samples two random
+ * heaps and takes the top of the one with the higher bound. Each heap
+ * publishes its current top bound so that comparison needs no lock. The
+ * popped node is therefore not always the global best, but with high
+ * probability it is close to it, so the search order stays near sequential
+ * best-first while threads rarely contend for the same lock.
+ */
+class MultiQueue {
+public:
+    /**
+     * @param num_threads Threads that will use the queue
+     * @param heaps_per_thread Heaps per thread (c in c·p)
+     */
+    MultiQueue(int num_threads, int heaps_per_thread = 2)
+        : num_heaps_(std::max(2, num_threads * heaps_per_thread)),
+          heaps_(new Heap[num_heaps_]) {}
+
+    ~MultiQueue() {
+        delete[] heaps_;
+    }
+
+    // Adds a node to a random heap; rng is the caller's xorshift state
+    void push(TreeNode* node, unsigned int& rng) {
+        while (true) {
+            Heap& heap = heaps_[next_random(rng) % num_heaps_];
+            if (!omp_test_lock(&heap.lock)) {
+                continue;  // Busy: another random heap is as good
+            }
+            heap.nodes.push_back(node);
+            std::push_heap(heap.nodes.begin(), heap.nodes.end(), CompareNode());
+            heap.publish();
+            omp_unset_lock(&heap.lock);
+            return;
+        }
+    }
+
+    /**
+     * Takes the higher-bound top of two random heaps. Returns nullptr after
+     * a full sweep finds every heap empty (the queue may still be refilled
+     * by a thread that is expanding a node).
+     */
+    TreeNode* pop(unsigned int& rng) {
+        for (int attempt = 0; attempt < 4; attempt++) {
+            int a = next_random(rng) % num_heaps_;
+            int b = next_random(rng) % num_heaps_;
+            if (heaps_[b].top_bound.load(std::memory_order_relaxed) >
+                heaps_[a].top_bound.load(std::memory_order_relaxed)) {
+                a = b;
+            }
+            TreeNode* node = pop_from(heaps_[a]);
+            if (node) {
+                return node;
+            }
+        }
+
+        // Sampling missed: sweep every heap before reporting empty
+        for (int i = 0; i < num_heaps_; i++) {
+            TreeNode* node = pop_from(heaps_[i]);
+            if (node) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // Highest published top bound, or a negative value if every heap is
+    // empty; a snapshot that may miss concurrent pushes and pops
+    float best_bound() const {
+        float best = EMPTY;
+        for (int i = 0; i < num_heaps_; i++) {
+            best = std::max(best, heaps_[i].top_bound.load(std::memory_order_relaxed));
+        }
+        return best;
+    }
+
+private:
+    MultiQueue(const MultiQueue&);
+    MultiQueue& operator=(const MultiQueue&);
+
+    // Sentinel published by an empty heap (bounds are never negative)
+    static constexpr float EMPTY = -1.0f;
+
+    // One locked heap, padded so neighbouring locks never share a cache line
+    struct Heap {
+        omp_lock_t lock;
+        std::vector<TreeNode*> nodes;
+        std::atomic<float> top_bound;
+        char padding[64];
+
+        Heap() : top_bound(EMPTY) {
+            omp_init_lock(&lock);
+        }
+
+        ~Heap() {
+            omp_destroy_lock(&lock);
+        }
+
+        // Caller holds the lock
+        void publish() {
+            top_bound.store(nodes.empty() ? EMPTY : nodes.front()->bound,
+                            std::memory_order_relaxed);
+        }
+    };
+
+    static unsigned int next_random(unsigned int& rng) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    static TreeNode* pop_from(Heap& heap) {
+        if (heap.top_bound.load(std::memory_order_relaxed) == EMPTY) {
+            return nullptr;
+        }
+        TreeNode* node = nullptr;
+        omp_set_lock(&heap.lock);
+        if (!heap.nodes.empty()) {
+            std::pop_heap(heap.nodes.begin(), heap.nodes.end(), CompareNode());
+            node = heap.nodes.back();
+            heap.nodes.pop_back();
+            heap.publish();
+        }
+        omp_unset_lock(&heap.lock);
+        return node;
+    }
+
+    int num_heaps_;
+    Heap* heaps_;
+};
+
+#endif // MULTI_QUEUE_H
@@ -0,0 +1,104 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <omp.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include "tree_node.h"
+
+/**
+ * Per-thread deque of open nodes for work-stealing search.
+ *
+ * The owning thread pushes and pops at the back, so it works depth-first on
+ * its most recent (deepest) nodes. Idle threads steal from the front, which
+ * holds the shallowest nodes and therefore the largest untouched subtrees.
+ * Every open node lives in exactly one deque, so no two threads ever search
+ * the same subtree.
+ *
+ * Padded by a cache line so the locks of neighbouring deques in an array
+ * never share one.
+ */
+class WorkDeque {
+public:
+    WorkDeque() : count_(0) {
+        omp_init_lock(&lock_);
+    }
+
+    ~WorkDeque() {
+        omp_destroy_lock(&lock_);
+    }
+
+    // Owner only: adds a node at the deep end
+    void push(TreeNode* node) {
+        omp_set_lock(&lock_);
+        nodes_.push_back(node);
+        count_.store((int)nodes_.size(), std::memory_order_relaxed);
+        omp_unset_lock(&lock_);
+    }
+
+    // Owner only: takes the deepest node, or nullptr when empty
+    TreeNode* pop() {
+        if (count_.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        TreeNode* node = nullptr;
+        omp_set_lock(&lock_);
+        if (!nodes_.empty()) {
+            node = nodes_.back();
+            nodes_.pop_back();
+            count_.store((int)nodes_.size(), std::memory_order_relaxed);
+        }
+        omp_unset_lock(&lock_);
+        return node;
+    }
+
+    /**
+     * Thief: takes the shallowest node, or nullptr when empty.
+     * On success idle_threads is decremented while the victim's lock is
+     * held; a non-empty deque means its owner is busy, so the idle count can
+     * never reach the team size while a node is in flight between threads.
+     */
+    TreeNode* steal(std::atomic<int>& idle_threads) {
+        if (count_.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        TreeNode* node = nullptr;
+        omp_set_lock(&lock_);
+        if (!nodes_.empty()) {
+            idle_threads.fetch_sub(1);
+            node = nodes_.front();
+            nodes_.pop_front();
+            count_.store((int)nodes_.size(), std::memory_order_relaxed);
+        }
+        omp_unset_lock(&lock_);
+        return node;
+    }
+
+    // Highest bound of the queued nodes, or -1 when empty (scans the deque)
+    float best_bound() {
+        float best = -1.0f;
+        omp_set_lock(&lock_);
+        for (size_t i = 0; i < nodes_.size(); i++) {
+            best = std::max(best, nodes_[i]->bound);
+        }
+        omp_unset_lock(&lock_);
+        return best;
+    }
+
+    // Approximate number of queued nodes (exact for the owner)
+    int size() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    WorkDeque(const WorkDeque&);
+    WorkDeque& operator=(const WorkDeque&);
+
+    omp_lock_t lock_;
+    std::deque<TreeNode*> nodes_;
+    std::atomic<int> count_;
+    char padding_[64];
+};
+
+#endif // WORK_STEALING_DEQUE_H
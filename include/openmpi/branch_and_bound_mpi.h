@@ -2,7 +2,9 @@
 #define BRANCH_AND_BOUND_MPI_H
 
 #include <mpi.h>
+#include <stdint.h>
 #include "parser/parser.h"
+#include "variable_fixing.h"
 
 struct MpiStats {
     int nodes_explored;
@@ -18,4 +20,24 @@ void branch_and_bound_mpi(Item* items,
                           MpiStats* stats,
                           MPI_Comm comm);
 
+// Picks the rank whose own best solution is highest and broadcasts its items
+// (read off decisions) to every rank. Collective; returns the item count and,
+// if best_items is non-null, stores a new[]-allocated copy of the items.
+int broadcast_best_solution(float own_best_value,
+                            const uint64_t* decisions,
+                            const Item* items,
+                            int item_count,
+                            Item** best_items,
+                            MPI_Comm comm);
+
+
+// Reduced-cost variable fixing for a whole job: rank 0 fixes the variables
+// (sorting its items) and broadcasts the reduced problem to every rank.
+// Collective.
+void fix_variables_shared(Item* items,
+                          int item_count,
+                          float capacity,
+                          ReducedProblem* out,
+                          MPI_Comm comm);
+
 #endif // BRANCH_AND_BOUND_MPI_H
@@ -0,0 +1,86 @@
+#ifndef INCUMBENT_WINDOW_H
+#define INCUMBENT_WINDOW_H
+
+#include <mpi.h>
+#include <algorithm>
+
+/**
+ * Global incumbent value shared through one-sided MPI (RMA).
+ *
+ * Rank 0 exposes a single float in an MPI window. A rank that improves its
+ * incumbent folds the value in with MPI_Accumulate(MPI_MAX), and ranks read
+ * the current maximum every few expansions with a request-based
+ * MPI_Rget_accumulate(MPI_NO_OP), completed with MPI_Test on a later read;
+ * until it completes the last known value is used. Both use a
+ * passive-target epoch opened once, so no rank ever waits for rank 0 or
+ * for the others to reach any synchronization point.
+ *
+ * Construction and destruction are collective over the communicator.
+ */
+class IncumbentWindow {
+public:
+    explicit IncumbentWindow(MPI_Comm comm)
+        : value_(nullptr), published_(0.0f), known_(0.0f), fetched_(0.0f),
+          unused_(0.0f), pending_(MPI_REQUEST_NULL) {
+        int rank = 0;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Aint bytes = rank == 0 ? (MPI_Aint)sizeof(float) : 0;
+        MPI_Win_allocate(bytes, sizeof(float), MPI_INFO_NULL, comm, &value_, &window_);
+        if (rank == 0) {
+            *value_ = 0.0f;
+        }
+        MPI_Barrier(comm);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+    }
+
+    ~IncumbentWindow() {
+        if (pending_ != MPI_REQUEST_NULL) {
+            MPI_Wait(&pending_, MPI_STATUS_IGNORE);
+        }
+        MPI_Win_unlock_all(window_);
+        MPI_Win_free(&window_);
+    }
+
+    // Raises the global incumbent to at least value (never blocks on peers)
+    void publish(float value) {
+        if (value <= published_) {
+            return;
+        }
+        published_ = value;
+        MPI_Accumulate(&published_, 1, MPI_FLOAT, 0, 0, 1, MPI_FLOAT, MPI_MAX, window_);
+        MPI_Win_flush_local(0, window_);
+    }
+
+    /**
+     * Latest known global incumbent (never blocks). Completes the read
+     * started by the previous call if it has arrived and starts the next
+     * one; a read still in flight leaves the last known value in place.
+     */
+    float fetch() {
+        if (pending_ != MPI_REQUEST_NULL) {
+            int complete = 0;
+            MPI_Test(&pending_, &complete, MPI_STATUS_IGNORE);
+            if (!complete) {
+                return known_;
+            }
+            known_ = std::max(known_, fetched_);
+        }
+        MPI_Rget_accumulate(&unused_, 1, MPI_FLOAT, &fetched_, 1, MPI_FLOAT,
+                            0, 0, 1, MPI_FLOAT, MPI_NO_OP, window_, &pending_);
+        return known_;
+    }
+
+private:
+    IncumbentWindow(const IncumbentWindow&);
+    IncumbentWindow& operator=(const IncumbentWindow&);
+
+    float* value_;
+    float published_;  // Origin buffer of the last accumulate
+    float known_;      // Largest incumbent read so far
+    float fetched_;    // Result buffer of the read in flight
+    float unused_;     // Origin buffer of the reads (ignored by MPI_NO_OP)
+    MPI_Request pending_;
+    MPI_Win window_;
+};
+
+#endif // INCUMBENT_WINDOW_H
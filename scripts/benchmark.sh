@@ -1,15 +1,27 @@
 #!/bin/bash
 
 # Consolidated benchmark script
+# Builds each benchmark driver once and passes it every dataset; results are
+# written to results/<implementation>_benchmarks.csv and .json
 # Usage: ./benchmark.sh [implementations...]
+# Environment: ITERATIONS (default 10) and WARMUP (default 1) runs per configuration
 # Examples:
 #   ./benchmark.sh sequential          # Run sequential benchmarks
 #   ./benchmark.sh openmp             # Run OpenMP benchmarks
 #   ./benchmark.sh sequential openmp  # Run both
+#   ./benchmark.sh sequential_bnb_mm  # Branch and bound with the Mueller-Merbach bound
+#   ./benchmark.sh sequential_bnb_fixed  # Branch and bound in fixed-point arithmetic
+#   ./benchmark.sh sequential_dp      # Run the dynamic-programming engine
+#   ./benchmark.sh sequential_subset  # Run the subset-sum bitset engine
+#   ./benchmark.sh sequential_pareto  # Run the sparse Pareto-list DP engine
+#   ./benchmark.sh sequential_mitm    # Run the meet-in-the-middle engine
+#   ./benchmark.sh openmp_tasks       # Run OpenMP with task-parallel scheduling
+#   ./benchmark.sh openmp_multiqueue  # Run OpenMP with a shared best-first queue
+#   ./benchmark.sh openmpi hybrid     # Compare pure MPI against MPI + OpenMP
 
 if [ $# -eq 0 ]; then
     echo "Usage: $0 [implementations...]"
-    echo "Available implementations: sequential, openmp, openmpi"
+    echo "Available implementations: sequential, sequential_bnb_mt2, sequential_bnb_mm, sequential_bnb_fixed, sequential_dp, sequential_subset, sequential_pareto, sequential_mitm, openmp, openmp_tasks, openmp_multiqueue, openmpi, hybrid"
     exit 1
 fi
 
@@ -27,66 +39,89 @@ datasets=(
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 ROOT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
 
+DATASET_PATHS=()
+for dataset in "${datasets[@]}"; do
+    IFS=':' read -r file desc <<< "$dataset"
+    DATASET_PATHS+=("data/$file")
+done
+
+ITERATIONS="${ITERATIONS:-10}"
+WARMUP="${WARMUP:-1}"
+
+# Starts a fresh CSV for an implementation (the driver writes the header)
+reset_results() {
+    rm -f "results/$1_benchmarks.csv"
+}
+RUN_OPTIONS="-i $ITERATIONS -w $WARMUP --results results"
+
+# Shared sources linked into every implementation
+COMMON_SOURCES="src/common/knapsack_utils.cpp
+    src/common/output_display.cpp
+    src/common/node_arena.cpp
+    src/common/prefix_bound.cpp
+    src/common/item_columns.cpp
+    src/common/node_codec.cpp
+    src/common/variable_fixing.cpp
+    src/common/bound_policy.cpp
+    src/common/primal_heuristic.cpp
+    src/common/dominance_table.cpp
+    src/common/search_telemetry.cpp
+    src/common/parser/parser.cpp
+    src/common/parser/instance_file.cpp
+    src/common/benchmark_harness.cpp"
+
 for impl in "$@"; do
     case $impl in
-        sequential)
+        sequential|sequential_bnb_mt2|sequential_bnb_mm|sequential_bnb_fixed|sequential_dp|sequential_subset|sequential_pareto|sequential_mitm)
+            # sequential uses branch and bound; sequential_<engine> selects another one
+            if [ "$impl" = "sequential" ]; then
+                ENGINE="bnb"
+            else
+                ENGINE="${impl#sequential_}"
+            fi
+
             echo "======================================================================"
-            echo "Running Sequential Benchmarks on All Datasets"
+            echo "Running Sequential Benchmarks on All Datasets (engine: $ENGINE)"
             echo "======================================================================"
             echo ""
-            
+
             cd "$ROOT_DIR"
-            mkdir -p out/sequential results
-            
-            # Clear previous results and write header
-            > results/sequential_benchmarks.csv
-            echo "dataset,implementation,threads,iterations,total_time_sec,avg_time_sec,nodes_explored,nodes_pruned,optimal_value" > results/sequential_benchmarks.csv
-            
-            for dataset in "${datasets[@]}"; do
-                IFS=':' read -r file desc <<< "$dataset"
-                
-                echo "======================================================================"
-                echo "Testing: $desc"
-                echo "File: data/$file"
-                echo "======================================================================"
-                
-                # Create test_config.h for this dataset
-                cat > include/sequential/test_config.h << EOF
-#ifndef TEST_CONFIG_H
-#define TEST_CONFIG_H
-#define TEST_FILE "data/$file"
-#endif
-EOF
-                
-                # Compile
-                g++ -std=c++11 -Iinclude/common -Iinclude/sequential \
-                    src/sequential/benchmark_sequential.cpp \
-                    src/sequential/branch_and_bound.cpp \
-                    src/common/knapsack_utils.cpp \
-                    src/common/output_display.cpp \
-                    src/common/parser/parser.cpp \
-                    -o out/sequential/benchmark_seq 2>/dev/null
-                
-                # Run and show only results
-                ./out/sequential/benchmark_seq 2>&1 | grep -A 20 "RESULTS"
-                
-                echo ""
-                echo ""
-            done
+            mkdir -p out/benchmark results
+
+            g++ -std=c++11 -O2 -fopenmp -Iinclude/common -Iinclude/openmp \
+                src/benchmark/benchmark.cpp \
+                src/sequential/branch_and_bound.cpp \
+                src/sequential/dynamic_programming.cpp \
+                src/sequential/subset_sum.cpp \
+                src/sequential/pareto_dp.cpp \
+                src/sequential/meet_in_the_middle.cpp \
+                src/sequential/branch_and_bound_fixed.cpp \
+                src/sequential/solvers.cpp \
+                src/openmp/branch_and_bound_parallel.cpp \
+                $COMMON_SOURCES \
+                -o out/benchmark/benchmark 2>/dev/null || { echo "Error: Build failed"; exit 1; }
+
+            reset_results "$impl"
+            ./out/benchmark/benchmark -e "$impl" $RUN_OPTIONS \
+                --json "results/${impl}_benchmarks.json" "${DATASET_PATHS[@]}"
+            echo ""
             ;;
-        openmp)
+        openmp|openmp_tasks|openmp_multiqueue)
+            # openmp uses work stealing; openmp_<strategy> selects another one
+            if [ "$impl" = "openmp" ]; then
+                STRATEGY="steal"
+            else
+                STRATEGY="${impl#openmp_}"
+            fi
+
             echo "======================================================================"
-            echo "Running OpenMP Benchmarks on All Datasets"
+            echo "Running OpenMP Benchmarks on All Datasets (strategy: $STRATEGY)"
             echo "======================================================================"
             echo ""
             
             cd "$ROOT_DIR"
-            mkdir -p out/openmp results
-            
-            # Clear previous results and write header
-            > results/openmp_benchmarks.csv
-            echo "dataset,implementation,threads,iterations,total_time_sec,avg_time_sec,nodes_explored,nodes_pruned,optimal_value" > results/openmp_benchmarks.csv
-            
+            mkdir -p out/benchmark results
+
             # Detect number of (logical) CPU cores
             if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
                 MAX_THREADS=$(sysctl -n hw.ncpu 2>/dev/null || echo "8")
@@ -99,7 +134,7 @@ EOF
             for ((t=2; t<=MAX_THREADS; t+=2)); do
                 THREAD_COUNTS+=("$t")
             done
-            if (( MAX_THREADS % 2 == 1 && MAX_THREADS > 1 )); then
+            if (( MAX_THREADS % 2 == 1 )); then
                 THREAD_COUNTS+=("$MAX_THREADS")
             fi
 
@@ -138,41 +173,24 @@ EOF
                 exit 1
             fi
             
-            for dataset in "${datasets[@]}"; do
-                IFS=':' read -r file desc <<< "$dataset"
-                
-                echo "======================================================================"
-                echo "Testing: $desc"
-                echo "File: data/$file"
-                echo "======================================================================"
-                
-                # Create test_config.h for this dataset
-                cat > include/openmp/test_config.h << EOF
-#ifndef TEST_CONFIG_H
-#define TEST_CONFIG_H
-#define TEST_FILE "data/$file"
-#endif
-EOF
-                
-                # Compile
-                $COMPILER -std=c++11 -Iinclude/common -Iinclude/openmp $OPENMP_FLAGS \
-                    src/openmp/benchmark_parallel.cpp \
-                    src/openmp/branch_and_bound_parallel.cpp \
-                    src/common/knapsack_utils.cpp \
-                    src/common/output_display.cpp \
-                    src/common/parser/parser.cpp \
-                    -o out/openmp/benchmark_par 2>/dev/null
-
-                # Run for each requested thread count and show only results
-                for threads in "${THREAD_COUNTS[@]}"; do
-                    echo ">>> Running with $threads OpenMP threads"
-                    ./out/openmp/benchmark_par "$threads" 2>&1 | grep -A 20 "RESULTS"
-                    echo ""
-                done
+            THREAD_LIST=$(IFS=,; echo "${THREAD_COUNTS[*]}")
+            $COMPILER -std=c++11 -O2 -Iinclude/common -Iinclude/openmp $OPENMP_FLAGS \
+                src/benchmark/benchmark.cpp \
+                src/sequential/branch_and_bound.cpp \
+                src/sequential/dynamic_programming.cpp \
+                src/sequential/subset_sum.cpp \
+                src/sequential/pareto_dp.cpp \
+                src/sequential/meet_in_the_middle.cpp \
+                src/sequential/branch_and_bound_fixed.cpp \
+                src/sequential/solvers.cpp \
+                src/openmp/branch_and_bound_parallel.cpp \
+                $COMMON_SOURCES \
+                -o out/benchmark/benchmark 2>/dev/null || { echo "Error: Build failed"; exit 1; }
 
-                echo ""
-                echo ""
-            done
+            reset_results "$impl"
+            ./out/benchmark/benchmark -e "$impl" -t "$THREAD_LIST" $RUN_OPTIONS \
+                --json "results/${impl}_benchmarks.json" "${DATASET_PATHS[@]}"
+            echo ""
             ;;
         openmpi)
             echo "======================================================================"
@@ -183,8 +201,7 @@ EOF
             cd "$ROOT_DIR"
             mkdir -p out/openmpi results
 
-            > results/openmpi_benchmarks.csv
-            echo "dataset,implementation,processes,iterations,total_time_sec,avg_time_sec,nodes_explored,nodes_pruned,optimal_value" > results/openmpi_benchmarks.csv
+            reset_results openmpi
 
             if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
                 MAX_PROCS=$(sysctl -n hw.ncpu 2>/dev/null || echo "8")
@@ -218,51 +235,86 @@ EOF
             echo ""
             echo ""
 
-            for dataset in "${datasets[@]}"; do
-                IFS=':' read -r file desc <<< "$dataset"
+            $MPI_COMPILER -std=c++11 -O2 -Iinclude/common -Iinclude/openmpi \
+                src/openmpi/benchmark_mpi.cpp \
+                src/openmpi/branch_and_bound_mpi.cpp \
+                $COMMON_SOURCES \
+                -o out/openmpi/benchmark_mpi 2>/dev/null || { echo "Error: Build failed"; exit 1; }
 
-                echo "======================================================================"
-                echo "Testing: $desc"
-                echo "File: data/$file"
-                echo "======================================================================"
+            for procs in "${PROC_COUNTS[@]}"; do
+                echo ">>> Running with $procs MPI processes"
+                mpirun -np "$procs" ./out/openmpi/benchmark_mpi $RUN_OPTIONS \
+                    --json "results/openmpi_${procs}p_benchmarks.json" "${DATASET_PATHS[@]}"
+                echo ""
+            done
+            ;;
+        hybrid)
+            echo "======================================================================"
+            echo "Running Hybrid MPI + OpenMP Benchmarks on All Datasets"
+            echo "======================================================================"
+            echo ""
 
-                cat > include/openmpi/test_config.h << EOF
-#ifndef TEST_CONFIG_H
-#define TEST_CONFIG_H
-#define TEST_FILE "data/$file"
-#endif
-EOF
+            cd "$ROOT_DIR"
+            mkdir -p out/hybrid results
 
-                # Detect OpenMP flags
-                if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
-                    LIBOMP_PREFIX=$(brew --prefix libomp 2>/dev/null || echo "/opt/homebrew/opt/libomp")
-                    OPENMP_FLAGS="-Xpreprocessor -fopenmp -I${LIBOMP_PREFIX}/include -L${LIBOMP_PREFIX}/lib -lomp"
-                else
-                    OPENMP_FLAGS="-fopenmp"
-                fi
+            reset_results hybrid
 
-                $MPI_COMPILER -std=c++11 -Iinclude/common -Iinclude/openmpi \
-                    src/openmpi/benchmark_mpi.cpp \
-                    src/openmpi/branch_and_bound_mpi.cpp \
-                    src/common/knapsack_utils.cpp \
-                    src/common/output_display.cpp \
-                    src/common/parser/parser.cpp \
-                    -o out/openmpi/benchmark_mpi 2>/dev/null
-
-                # Run for each requested process count and show only results
-                for procs in "${PROC_COUNTS[@]}"; do
-                    echo ">>> Running with $procs MPI processes"
-                    mpirun -np "$procs" ./out/openmpi/benchmark_mpi 2>&1 | grep -A 20 "RESULTS"
-                    echo ""
-                done
+            if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
+                MAX_CORES=$(sysctl -n hw.ncpu 2>/dev/null || echo "8")
+            else
+                MAX_CORES=$(nproc 2>/dev/null || echo "8")
+            fi
 
-                echo ""
+            # Process counts 1,2,4,... up to the core count; each process
+            # gets an equal share of the cores as OpenMP threads
+            PROC_COUNTS=()
+            for ((p=1; p<=MAX_CORES; p*=2)); do
+                PROC_COUNTS+=("$p")
+            done
+
+            if command -v mpic++ &> /dev/null; then
+                MPI_COMPILER="mpic++"
+            elif command -v mpicc &> /dev/null; then
+                MPI_COMPILER="mpicc"
+            else
+                echo "Error: mpic++ (MPI C++ compiler) not found"
+                exit 1
+            fi
+
+            if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
+                LIBOMP_PREFIX=$(brew --prefix libomp 2>/dev/null || echo "/opt/homebrew/opt/libomp")
+                OPENMP_FLAGS="-Xpreprocessor -fopenmp -I${LIBOMP_PREFIX}/include -L${LIBOMP_PREFIX}/lib -lomp"
+            else
+                OPENMP_FLAGS="-fopenmp"
+            fi
+
+            echo "Detected cores: $MAX_CORES"
+            echo -n "Running hybrid benchmarks with process counts:"
+            for p in "${PROC_COUNTS[@]}"; do
+                echo -n " $p"
+            done
+            echo ""
+            echo ""
+
+            $MPI_COMPILER -std=c++11 -O2 -Iinclude/common -Iinclude/hybrid \
+                -Iinclude/openmp -Iinclude/openmpi $OPENMP_FLAGS \
+                src/hybrid/benchmark_hybrid.cpp \
+                src/hybrid/branch_and_bound_hybrid.cpp \
+                src/openmpi/branch_and_bound_mpi.cpp \
+                $COMMON_SOURCES \
+                -o out/hybrid/benchmark_hybrid 2>/dev/null || { echo "Error: Build failed"; exit 1; }
+
+            for procs in "${PROC_COUNTS[@]}"; do
+                threads=$(( MAX_CORES / procs ))
+                echo ">>> Running with $procs MPI processes x $threads OpenMP threads"
+                mpirun -np "$procs" ./out/hybrid/benchmark_hybrid -t "$threads" $RUN_OPTIONS \
+                    --json "results/hybrid_${procs}p_benchmarks.json" "${DATASET_PATHS[@]}"
                 echo ""
             done
             ;;
         *)
             echo "Unknown implementation: $impl"
-            echo "Available: sequential, openmp, openmpi"
+            echo "Available: sequential, sequential_bnb_mt2, sequential_bnb_mm, sequential_bnb_fixed, sequential_dp, sequential_subset, sequential_pareto, sequential_mitm, openmp, openmp_tasks, openmp_multiqueue, openmpi, hybrid"
             exit 1
             ;;
     esac
@@ -1,25 +1,52 @@
 #!/bin/bash
 
 # Consolidated run script
-# Usage: ./run.sh <dataset> <implementation> [num_threads]
+# Usage: ./run.sh <dataset> <implementation> [num_threads] [strategy]
 # Examples:
 #   ./run.sh benchmark_ultimate_121items.txt sequential
+#   ./run.sh benchmark_ultimate_121items.txt sequential 64   # 64 MiB frontier
+#   ./run.sh benchmark_ultimate_121items.txt sequential 0 dp # dynamic programming
 #   ./run.sh benchmark_medium_100items.txt openmp 4
+#   ./run.sh benchmark_medium_100items.txt openmp 4 tasks
+#   TRACE=trace.csv ./run.sh benchmark_medium_100items.txt openmp 4   # incumbent trace
+#   ./run.sh benchmark_medium_100items.txt hybrid 2 8   # 2 processes x 8 threads
 
 if [ $# -lt 2 ]; then
-    echo "Usage: $0 <dataset> <implementation> [workers]"
-    echo "Datasets: benchmark_*.txt files in data/"
-    echo "Implementations: sequential, openmp, openmpi"
+    echo "Usage: $0 <dataset> <implementation> [workers] [strategy]"
+    echo "Datasets: benchmark_*.txt files in data/ (or binary instances, see convert_dataset)"
+    echo "Implementations: sequential, openmp, openmpi, hybrid"
+    echo "OpenMP strategies: steal (default), tasks, multiqueue"
+    echo "Hybrid: [workers] is MPI processes, followed by threads per process"
+    echo "Sequential: [workers] is an optional frontier memory budget in MiB"
+    echo "Sequential engines: bnb (default), bnb_mt2, bnb_mm, bnb_fixed, dp, subset, pareto, mitm"
     exit 1
 fi
 
 DATASET="$1"
 IMPL="$2"
 NUM_THREADS="$3"  # Optional third parameter
+FRONTIER_MB="$3"  # Sequential: frontier memory budget in MiB
+STRATEGY="${4:-steal}"  # Optional OpenMP scheduling strategy
+ENGINE="${4:-bnb}"      # Sequential: solver engine
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 ROOT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
 
+# Shared sources linked into every implementation
+COMMON_SOURCES="src/common/knapsack_utils.cpp
+    src/common/output_display.cpp
+    src/common/node_arena.cpp
+    src/common/prefix_bound.cpp
+    src/common/item_columns.cpp
+    src/common/node_codec.cpp
+    src/common/variable_fixing.cpp
+    src/common/bound_policy.cpp
+    src/common/primal_heuristic.cpp
+    src/common/dominance_table.cpp
+    src/common/search_telemetry.cpp
+    src/common/parser/parser.cpp
+    src/common/parser/instance_file.cpp"
+
 # If no worker count specified for OpenMP, detect number of cores
 if [ "$IMPL" = "openmp" ] && [ -z "$NUM_THREADS" ]; then
     if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
@@ -39,6 +66,25 @@ if [ "$IMPL" = "openmpi" ] && [ -z "$NUM_THREADS" ]; then
     echo "Auto-detected $NUM_THREADS MPI processes"
 fi
 
+# Hybrid: one MPI process unless given, with the cores split between processes
+if [ "$IMPL" = "hybrid" ]; then
+    NUM_PROCS="${NUM_THREADS:-1}"
+    if [ -n "$4" ]; then
+        THREADS_PER_PROC="$4"
+    else
+        if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
+            CORES=$(sysctl -n hw.ncpu 2>/dev/null || echo "8")
+        else
+            CORES=$(nproc 2>/dev/null || echo "8")
+        fi
+        THREADS_PER_PROC=$(( CORES / NUM_PROCS ))
+        if (( THREADS_PER_PROC < 1 )); then
+            THREADS_PER_PROC=1
+        fi
+        echo "Auto-selected $THREADS_PER_PROC threads per MPI process"
+    fi
+fi
+
 # Default to 4 threads if still not set (for backward compatibility)
 NUM_THREADS="${NUM_THREADS:-4}"
 
@@ -56,12 +102,16 @@ case $IMPL in
 EOF
         
         # Compile
-        g++ -std=c++11 -Iinclude/common -Iinclude/sequential \
+        g++ -std=c++11 -fopenmp -Iinclude/common -Iinclude/sequential \
             src/sequential/index.cpp \
             src/sequential/branch_and_bound.cpp \
-            src/common/knapsack_utils.cpp \
-            src/common/output_display.cpp \
-            src/common/parser/parser.cpp \
+            src/sequential/dynamic_programming.cpp \
+            src/sequential/subset_sum.cpp \
+            src/sequential/pareto_dp.cpp \
+            src/sequential/meet_in_the_middle.cpp \
+            src/sequential/branch_and_bound_fixed.cpp \
+            src/sequential/solvers.cpp \
+            $COMMON_SOURCES \
             -o out/sequential/index 2>/dev/null
         
         if [ $? -eq 0 ]; then
@@ -69,7 +119,7 @@ EOF
             echo ""
             echo "Running sequential version..."
             echo ""
-            ./out/sequential/index
+            ./out/sequential/index "${FRONTIER_MB:-0}" "$ENGINE"
         else
             echo "✗ Build failed!"
             exit 1
@@ -118,17 +168,15 @@ EOF
         $COMPILER -std=c++11 -Iinclude/common -Iinclude/openmp $OPENMP_FLAGS \
             src/openmp/index.cpp \
             src/openmp/branch_and_bound_parallel.cpp \
-            src/common/knapsack_utils.cpp \
-            src/common/output_display.cpp \
-            src/common/parser/parser.cpp \
+            $COMMON_SOURCES \
             -o out/openmp/index 2>/dev/null
         
         if [ $? -eq 0 ]; then
             echo "✓ Build successful!"
             echo ""
-            echo "Running OpenMP version with $NUM_THREADS threads..."
+            echo "Running OpenMP version with $NUM_THREADS threads ($STRATEGY)..."
             echo ""
-            ./out/openmp/index $NUM_THREADS
+            ./out/openmp/index $NUM_THREADS $STRATEGY $TRACE
         else
             echo "✗ Build failed!"
             exit 1
@@ -158,9 +206,7 @@ EOF
         $MPI_COMPILER -std=c++11 -Iinclude/common -Iinclude/openmpi \
             src/openmpi/index.cpp \
             src/openmpi/branch_and_bound_mpi.cpp \
-            src/common/knapsack_utils.cpp \
-            src/common/output_display.cpp \
-            src/common/parser/parser.cpp \
+            $COMMON_SOURCES \
             -o out/openmpi/index 2>/dev/null
 
         if [ $? -eq 0 ]; then
@@ -174,9 +220,56 @@ EOF
             exit 1
         fi
         ;;
+    hybrid)
+        cd "$ROOT_DIR"
+        mkdir -p out/hybrid
+
+        if command -v mpic++ &> /dev/null; then
+            MPI_COMPILER="mpic++"
+        elif command -v mpicc &> /dev/null; then
+            MPI_COMPILER="mpicc"
+        else
+            echo "Error: mpic++ (MPI C++ compiler) not found"
+            exit 1
+        fi
+
+        if [[ "$OSTYPE" == "darwin"* ]] || [[ "$(uname)" == "Darwin" ]]; then
+            LIBOMP_PREFIX=$(brew --prefix libomp 2>/dev/null || echo "/opt/homebrew/opt/libomp")
+            OPENMP_FLAGS="-Xpreprocessor -fopenmp -I${LIBOMP_PREFIX}/include -L${LIBOMP_PREFIX}/lib -lomp"
+        else
+            OPENMP_FLAGS="-fopenmp"
+        fi
+
+        cat > include/hybrid/test_config.h << EOF
+#ifndef TEST_CONFIG_H
+#define TEST_CONFIG_H
+#define TEST_FILE "data/$DATASET"
+#endif
+EOF
+
+        # Compile hybrid version (reuses the MPI and OpenMP helpers)
+        $MPI_COMPILER -std=c++11 -Iinclude/common -Iinclude/hybrid \
+            -Iinclude/openmp -Iinclude/openmpi $OPENMP_FLAGS \
+            src/hybrid/index.cpp \
+            src/hybrid/branch_and_bound_hybrid.cpp \
+            src/openmpi/branch_and_bound_mpi.cpp \
+            $COMMON_SOURCES \
+            -o out/hybrid/index 2>/dev/null
+
+        if [ $? -eq 0 ]; then
+            echo "✓ Build successful!"
+            echo ""
+            echo "Running hybrid version with $NUM_PROCS processes x $THREADS_PER_PROC threads..."
+            echo ""
+            mpirun -np "$NUM_PROCS" ./out/hybrid/index "$THREADS_PER_PROC"
+        else
+            echo "✗ Build failed!"
+            exit 1
+        fi
+        ;;
     *)
         echo "Unknown implementation: $IMPL"
-        echo "Available: sequential, openmp, openmpi"
+        echo "Available: sequential, openmp, openmpi, hybrid"
         exit 1
         ;;
 esac
\ No newline at end of file
@@ -0,0 +1,191 @@
+/**
+ * Benchmark driver for the sequential and OpenMP engines
+ * Runs every combination of dataset, engine and thread count given on the
+ * command line: warm-up runs first, then timed runs summarized as min,
+ * median, p95 and standard deviation. Results are appended to the CSV files
+ * in results/ and can also be written as JSON.
+ *
+ * Usage: ./benchmark [options] <dataset>...   (see --help)
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -fopenmp -Iinclude/common -Iinclude/openmp src/benchmark/benchmark.cpp \
+ *       src/sequential/{branch_and_bound,branch_and_bound_fixed,dynamic_programming,subset_sum,pareto_dp,meet_in_the_middle,solvers}.cpp \
+ *       src/openmp/branch_and_bound_parallel.cpp src/common/benchmark_harness.cpp \
+ *       $COMMON_SOURCES -o benchmark
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "parser/parser.h"
+#include "solvers.h"
+#include "search_options.h"
+#include "branch_and_bound_parallel.h"
+#include "output_display.h"
+#include "search_telemetry.h"
+#include "variable_fixing.h"
+#include "benchmark_harness.h"
+
+namespace {
+
+// An implementation name resolved to the engine that runs it
+struct Engine {
+    std::string name;
+    Solver solver;             // sequential engines
+    ParallelSolver parallel;   // OpenMP strategies
+};
+
+// Resolves sequential, sequential_<engine>, openmp and openmp_<strategy>
+bool resolve_engine(const std::string& name, Engine* engine) {
+    engine->name = name;
+    engine->solver = nullptr;
+    engine->parallel = nullptr;
+    if (name == "sequential") {
+        engine->solver = solver_for("bnb");
+    } else if (name.compare(0, 11, "sequential_") == 0) {
+        engine->solver = solver_for(name.c_str() + 11);
+    } else if (name == "openmp") {
+        engine->parallel = parallel_solver_for("steal");
+    } else if (name.compare(0, 7, "openmp_") == 0) {
+        engine->parallel = parallel_solver_for(name.c_str() + 7);
+    }
+    return engine->solver != nullptr || engine->parallel != nullptr;
+}
+
+// Result of a single run
+struct RunOutcome {
+    double seconds;
+    float value;
+    int nodes_explored;
+    int nodes_pruned;
+};
+
+/**
+ * Solves one fresh copy of the instance and times only the engine call
+ * (the copy is made first because engines sort the items in place).
+ */
+RunOutcome run_once(const Engine& engine, const std::vector<Item>& items, float capacity,
+                    int threads, const SearchOptions& options) {
+    std::vector<Item> copy(items);
+    int n = (int)copy.size();
+
+    RunOutcome outcome;
+    outcome.value = 0.0f;
+    outcome.nodes_explored = 0;
+    outcome.nodes_pruned = 0;
+    Item* best_items = nullptr;
+    int best_count = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    if (engine.solver) {
+        run_solver(engine.solver, copy.data(), n, capacity,
+                   &outcome.value, &best_items, &best_count,
+                   &outcome.nodes_explored, &outcome.nodes_pruned, &options);
+    } else {
+        engine.parallel(copy.data(), n, capacity,
+                        &outcome.value, &best_items, &best_count, threads,
+                        &outcome.nodes_explored, &outcome.nodes_pruned);
+    }
+    auto end = std::chrono::steady_clock::now();
+    outcome.seconds = std::chrono::duration<double>(end - start).count();
+
+    delete[] best_items;
+    return outcome;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    if (!parse_benchmark_args(argc, argv, &config)) {
+        return 1;
+    }
+
+    if (config.thread_counts.empty()) {
+        config.thread_counts.push_back(1);
+    }
+
+    std::vector<Engine> engines(config.engines.size());
+    for (size_t e = 0; e < engines.size(); e++) {
+        if (!resolve_engine(config.engines[e], &engines[e])) {
+            printf("Error: Unknown engine '%s' (see --help)\n", config.engines[e].c_str());
+            return 1;
+        }
+    }
+
+    SearchOptions options;
+    options.frontier_budget_bytes = (size_t)(config.frontier_budget_mb * 1024.0 * 1024.0);
+    options.fix_variables = config.fix_variables;
+    set_variable_fixing(config.fix_variables);
+
+    // Timed runs do no console I/O unless asked for
+    set_search_output(config.verbose);
+    set_search_trace_file(config.trace_file);
+
+    printf("Knapsack Benchmark\n");
+    printf("======================================\n");
+    printf("Datasets: %zu, engines: %zu, thread counts: %zu\n",
+           config.datasets.size(), engines.size(), config.thread_counts.size());
+    printf("Warm-up runs: %d, timed runs: %d\n\n", config.warmup, config.iterations);
+
+    std::vector<BenchmarkResult> results;
+    int status = 0;
+    for (size_t d = 0; d < config.datasets.size(); d++) {
+        const char* path = config.datasets[d].c_str();
+        int item_count = 0;
+        float capacity = 0.0f;
+        Item* loaded = read_items(path, &item_count, &capacity);
+        if (loaded == nullptr) {
+            printf("Error: Failed to load items from file %s\n", path);
+            status = 1;
+            continue;
+        }
+        std::vector<Item> items(loaded, loaded + item_count);
+        delete[] loaded;
+
+        for (size_t e = 0; e < engines.size(); e++) {
+            for (size_t t = 0; t < config.thread_counts.size(); t++) {
+                int threads = config.thread_counts[t];
+                options.num_threads = threads;
+
+                for (int w = 0; w < config.warmup; w++) {
+                    run_once(engines[e], items, capacity, threads, options);
+                }
+
+                BenchmarkResult result;
+                result.dataset = dataset_name(path);
+                result.implementation = engines[e].name;
+                result.threads = threads;
+                result.warmup = config.warmup;
+                for (int i = 0; i < config.iterations; i++) {
+                    RunOutcome run = run_once(engines[e], items, capacity, threads, options);
+                    // Engines may sum the same solution in a different order
+                    float drift = fabsf(run.value - result.optimal_value);
+                    if (i > 0 && drift > 1e-5f * fabsf(result.optimal_value)) {
+                        printf("Warning: %s on %s found %.2f after %.2f in an earlier run\n",
+                               engines[e].name.c_str(), result.dataset.c_str(),
+                               run.value, result.optimal_value);
+                    }
+                    result.seconds.push_back(run.seconds);
+                    result.optimal_value = run.value;
+                    result.nodes_explored += run.nodes_explored;
+                    result.nodes_pruned += run.nodes_pruned;
+                }
+                result.timing = summarize_timings(result.seconds);
+
+                print_benchmark_result(result);
+                if (!config.results_dir.empty()) {
+                    append_benchmark_csv(config.results_dir, result);
+                }
+                results.push_back(result);
+            }
+        }
+    }
+
+    if (!config.json_file.empty() && write_benchmark_json(config.json_file, results)) {
+        printf("\nResults written to %s\n", config.json_file.c_str());
+    }
+    return status;
+}
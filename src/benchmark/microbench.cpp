@@ -0,0 +1,585 @@
+/**
+ * Microbenchmarks for the branch and bound hot paths
+ * Times each kernel in isolation on generated instances, so a change to
+ * one of them can be measured without the noise of a whole search:
+ *
+ *   bound_reference     calculate_bound, the O(n) reference bound
+ *   bound_dantzig       DantzigBound (prefix sums, O(log n))
+ *   bound_mt2           MartelloTothBound (U2)
+ *   bound_mm            MullerMerbachBound (SIMD flip scan)
+ *   node_add            TreeNode::add from the arena, then recycle
+ *   heap                CompareNode priority queue: pop the best node and
+ *                       push a child, at a fixed queue size
+ *   sort_items          sort_items (precomputed ratio keys)
+ *   sort_compare_items  std::sort with compare_items
+ *
+ * Instances come from the generate_dataset distributions. Bound kernels run
+ * on nodes sampled along a random root-to-leaf path, each with its
+ * parent's critical index as search hint, as in the search. node_add and
+ * heap do not depend on the item values and run once per n (distribution
+ * "-"); heap also runs once per queue size.
+ *
+ * Each measurement repeats until --min-time has passed, --repeats times;
+ * the ns per operation of the repeats are summarized as min, median, p95
+ * and standard deviation. Rows go to stdout as CSV and can be appended to
+ * a CSV file (for tracking over time) and written as JSON.
+ *
+ * Usage: ./microbench [options]   (see --help)
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -Iinclude/common src/benchmark/microbench.cpp \
+ *       src/common/benchmark_harness.cpp src/common/instance_generator.cpp \
+ *       $COMMON_SOURCES -o microbench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <queue>
+#include <string>
+#include <vector>
+#include "parser/parser.h"
+#include "tree_node.h"
+#include "node_arena.h"
+#include "knapsack_utils.h"
+#include "bound_policy.h"
+#include "instance_generator.h"
+#include "benchmark_harness.h"
+
+namespace {
+
+const char* const KERNELS[] = {
+    "bound_reference", "bound_dantzig", "bound_mt2", "bound_mm",
+    "node_add", "heap", "sort_items", "sort_compare_items"
+};
+const int KERNEL_COUNT = 8;
+
+// Nodes sampled for the bound and node_add kernels
+const int SAMPLE_NODES = 256;
+
+// Operations per timed batch of the node_add and heap kernels
+const int NODE_BATCH = 4096;
+
+// Largest queue the heap kernel builds (queue size times node size)
+const size_t HEAP_MAX_BYTES = (size_t)512 << 20;
+
+struct MicroConfig {
+    std::vector<int> sizes;
+    std::vector<std::string> distributions;
+    std::vector<int> queue_sizes;
+    std::vector<std::string> kernels;
+    float capacity_pct;
+    unsigned seed;
+    int repeats;
+    double min_time;
+    std::string csv_file;
+    std::string json_file;
+
+    MicroConfig()
+        : capacity_pct(50.0f), seed(1), repeats(5), min_time(0.05) {
+        sizes.push_back(100);
+        sizes.push_back(1000);
+        sizes.push_back(10000);
+        sizes.push_back(100000);
+        distributions.assign(DISTRIBUTIONS, DISTRIBUTIONS + DISTRIBUTION_COUNT);
+        queue_sizes.push_back(1000);
+        queue_sizes.push_back(100000);
+        queue_sizes.push_back(1000000);
+        kernels.assign(KERNELS, KERNELS + KERNEL_COUNT);
+    }
+};
+
+// One measured configuration
+struct MicroResult {
+    std::string kernel;
+    std::string distribution;
+    int n;
+    int queue_size;          // 0 for kernels without a queue
+    const char* unit;        // what one operation is
+    long long ops;           // operations timed over all repeats
+    TimingSummary ns;        // ns per operation across the repeats
+};
+
+// Keeps the compiler from dropping the work being timed
+volatile float sink;
+
+bool contains(const std::vector<std::string>& list, const char* name) {
+    return std::find(list.begin(), list.end(), name) != list.end();
+}
+
+void print_usage(const char* program) {
+    printf("Usage: %s [options]\n", program);
+    printf("\nOptions:\n");
+    printf("  -n, --sizes LIST       Item counts (default: 100,1000,10000,100000)\n");
+    printf("  -d, --dist LIST        Distributions (default: all of generate_dataset's)\n");
+    printf("  -q, --queue LIST       Queue sizes for the heap kernel (default: 1000,100000,1000000)\n");
+    printf("  -k, --kernels LIST     Kernels (default: all)\n");
+    printf("  -c, --capacity PCT     Capacity as a percentage of total weight (default: 50)\n");
+    printf("  -s, --seed N           Instance seed (default: 1)\n");
+    printf("  -r, --repeats N        Measurements per configuration (default: 5)\n");
+    printf("  -m, --min-time SEC     Minimum time per measurement (default: 0.05)\n");
+    printf("      --csv FILE         Also append the rows to FILE\n");
+    printf("      --json FILE        Also write all results to FILE as JSON\n");
+    printf("\nKernels:");
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        printf(" %s", KERNELS[k]);
+    }
+    printf("\n\nExample: %s -k bound_dantzig,bound_mm -n 1000 -d subset_sum --csv results/microbench.csv\n",
+           program);
+}
+
+bool parse_int_list(const char* text, int minimum, std::vector<int>* out) {
+    std::vector<std::string> parts = split_list(text);
+    out->clear();
+    for (size_t i = 0; i < parts.size(); i++) {
+        int value = 0;
+        if (!parse_count(parts[i].c_str(), minimum, &value)) {
+            return false;
+        }
+        out->push_back(value);
+    }
+    return !out->empty();
+}
+
+bool parse_args(int argc, char* argv[], MicroConfig* config) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            print_usage(argv[0]);
+            return false;
+        }
+        if (i + 1 >= argc) {
+            printf("Error: Option %s needs a value\n", arg);
+            return false;
+        }
+        const char* value = argv[++i];
+        if (strcmp(arg, "-n") == 0 || strcmp(arg, "--sizes") == 0) {
+            if (!parse_int_list(value, 1, &config->sizes)) {
+                printf("Error: Item counts must be >= 1, got '%s'\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "-q") == 0 || strcmp(arg, "--queue") == 0) {
+            if (!parse_int_list(value, 1, &config->queue_sizes)) {
+                printf("Error: Queue sizes must be >= 1, got '%s'\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "-d") == 0 || strcmp(arg, "--dist") == 0) {
+            config->distributions = split_list(value);
+            for (size_t d = 0; d < config->distributions.size(); d++) {
+                const char* const* end = DISTRIBUTIONS + DISTRIBUTION_COUNT;
+                if (std::find_if(DISTRIBUTIONS, end, [&](const char* name) {
+                        return config->distributions[d] == name;
+                    }) == end) {
+                    printf("Error: Unknown distribution '%s'\n", config->distributions[d].c_str());
+                    return false;
+                }
+            }
+        } else if (strcmp(arg, "-k") == 0 || strcmp(arg, "--kernels") == 0) {
+            config->kernels = split_list(value);
+            for (size_t k = 0; k < config->kernels.size(); k++) {
+                if (std::find_if(KERNELS, KERNELS + KERNEL_COUNT, [&](const char* name) {
+                        return config->kernels[k] == name;
+                    }) == KERNELS + KERNEL_COUNT) {
+                    printf("Error: Unknown kernel '%s' (see --help)\n", config->kernels[k].c_str());
+                    return false;
+                }
+            }
+        } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--capacity") == 0) {
+            config->capacity_pct = (float)atof(value);
+            if (config->capacity_pct <= 0.0f || config->capacity_pct > 100.0f) {
+                printf("Error: Capacity percentage must be between 0 and 100\n");
+                return false;
+            }
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--seed") == 0) {
+            config->seed = (unsigned)strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--repeats") == 0) {
+            if (!parse_count(value, 1, &config->repeats)) {
+                printf("Error: Repeats must be >= 1, got '%s'\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "-m") == 0 || strcmp(arg, "--min-time") == 0) {
+            config->min_time = atof(value);
+            if (config->min_time <= 0.0) {
+                printf("Error: Minimum time must be > 0 seconds\n");
+                return false;
+            }
+        } else if (strcmp(arg, "--csv") == 0) {
+            config->csv_file = value;
+        } else if (strcmp(arg, "--json") == 0) {
+            config->json_file = value;
+        } else {
+            printf("Error: Unknown option %s (see --help)\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Times a kernel. batch(&ops) runs one batch, adds the operations it did
+ * to ops and returns the seconds they took (so setup inside a batch can
+ * stay untimed). One untimed batch warms up caches and the branch
+ * predictor first.
+ *
+ * @return ns per operation of each repeat
+ */
+template <typename Batch>
+std::vector<double> measure(Batch batch, int repeats, double min_time, long long* total_ops) {
+    long long ops = 0;
+    batch(&ops);
+    *total_ops = 0;
+
+    std::vector<double> ns_per_op;
+    for (int r = 0; r < repeats; r++) {
+        ops = 0;
+        double seconds = 0.0;
+        while (seconds < min_time) {
+            seconds += batch(&ops);
+        }
+        ns_per_op.push_back(seconds * 1e9 / ops);
+        *total_ops += ops;
+    }
+    return ns_per_op;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// A generated instance, its items sorted, with nodes sampled for the bounds
+struct Instance {
+    std::vector<Item> unsorted;
+    std::vector<Item> items;
+    float capacity;
+    int words;
+    NodeArena arena;
+    std::vector<TreeNode*> nodes;
+    std::vector<int> hints;   // critical index of each node's parent
+
+    Instance(int n) : capacity(0.0f), words(TreeNode::decision_words(n)),
+                      arena(1, TreeNode::bytes_for(n)) {}
+};
+
+/**
+ * Generates an instance and walks one random path down its sorted items,
+ * taking each item that fits with probability 1/2. SAMPLE_NODES nodes
+ * spread evenly over the levels are kept, each hinted with the critical
+ * index of the node one level above it.
+ */
+void build_instance(const char* distribution, int n, const MicroConfig& config,
+                    Instance* instance) {
+    srand(config.seed);
+    Dataset dataset;
+    generate_items(n, distribution, &dataset);
+    instance->unsorted.resize(n);
+    for (int i = 0; i < n; i++) {
+        instance->unsorted[i].id = i;
+        instance->unsorted[i].value = dataset.values[i];
+        instance->unsorted[i].weight = dataset.weights[i];
+    }
+    instance->capacity = two_decimals(dataset.total_weight * (config.capacity_pct / 100.0f));
+    instance->items = instance->unsorted;
+    sort_items(instance->items.data(), n);
+
+    PrefixBound prefix(instance->items.data(), n, instance->capacity);
+    int samples = std::min(n, SAMPLE_NODES);
+    int next_sample = 0;
+    float t_weight = 0.0f;
+    float t_value = 0.0f;
+    int parent_critical = 0;
+    for (int level = -1; level < n - 1 && next_sample < samples; level++) {
+        if (level >= 0) {
+            const Item& item = instance->items[level];
+            if (t_weight + item.weight <= instance->capacity && (rand() & 1)) {
+                t_weight += item.weight;
+                t_value += item.value;
+            }
+        }
+        int critical = parent_critical;
+        prefix.bound(level, t_weight, t_value, &critical);
+        // Sample levels -1 .. n - 2 evenly
+        if ((long long)(level + 1) * samples >= (long long)next_sample * n) {
+            TreeNode* node = TreeNode::create_root(instance->arena, 0, instance->words);
+            node->level = level;
+            node->t_weight = t_weight;
+            node->t_value = t_value;
+            instance->nodes.push_back(node);
+            instance->hints.push_back(parent_critical);
+            next_sample++;
+        }
+        parent_critical = critical;
+    }
+}
+
+// One batch of bound evaluations over the sampled nodes
+template <typename BoundFn>
+double bound_batch(Instance* instance, BoundFn bound, long long* ops) {
+    std::vector<TreeNode*>& nodes = instance->nodes;
+    float sum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i]->critical = instance->hints[i];
+        sum += bound(nodes[i]);
+    }
+    double seconds = seconds_since(start);
+    sink = sum;
+    *ops += (long long)nodes.size();
+    return seconds;
+}
+
+template <typename Policy>
+std::vector<double> measure_policy(Instance* instance, const MicroConfig& config, long long* ops) {
+    Policy policy(instance->items.data(), (int)instance->items.size(), instance->capacity);
+    return measure([&](long long* count) {
+        return bound_batch(instance, [&](TreeNode* node) { return policy.bound(node); }, count);
+    }, config.repeats, config.min_time, ops);
+}
+
+std::vector<double> measure_sort(const Instance& instance, bool keyed, const MicroConfig& config,
+                                 long long* ops) {
+    std::vector<Item> work(instance.unsorted.size());
+    return measure([&](long long* count) {
+        std::copy(instance.unsorted.begin(), instance.unsorted.end(), work.begin());
+        auto start = std::chrono::steady_clock::now();
+        if (keyed) {
+            sort_items(work.data(), (int)work.size());
+        } else {
+            std::sort(work.begin(), work.end(), compare_items);
+        }
+        double seconds = seconds_since(start);
+        sink = work[0].value;
+        *count += (long long)work.size();
+        return seconds;
+    }, config.repeats, config.min_time, ops);
+}
+
+std::vector<double> measure_node_add(Instance* instance, const MicroConfig& config,
+                                     long long* ops) {
+    NodeArena& arena = instance->arena;
+    const std::vector<TreeNode*>& nodes = instance->nodes;
+    int words = instance->words;
+    return measure([&](long long* count) {
+        int level_sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NODE_BATCH; i++) {
+            const TreeNode* parent = nodes[i % nodes.size()];
+            TreeNode* child = parent->add(arena, 0, words, (i & 1) != 0,
+                                          parent->t_weight, parent->t_value);
+            level_sum += child->level;
+            arena.recycle(child, 0);
+        }
+        double seconds = seconds_since(start);
+        sink = (float)level_sum;
+        *count += NODE_BATCH;
+        return seconds;
+    }, config.repeats, config.min_time, ops);
+}
+
+/**
+ * Heap kernel: a queue of queue_size nodes with random bounds; each
+ * operation pops the best node and pushes it back as its own child, with
+ * a bound slightly below the parent's, as an expansion does.
+ */
+std::vector<double> measure_heap(int n, int queue_size, const MicroConfig& config,
+                                 long long* ops) {
+    NodeArena arena(1, TreeNode::bytes_for(n));
+    int words = TreeNode::decision_words(n);
+    std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> pq;
+    srand(config.seed);
+    for (int i = 0; i < queue_size; i++) {
+        TreeNode* node = TreeNode::create_root(arena, 0, words);
+        node->bound = (float)rand() / RAND_MAX * 1000.0f;
+        pq.push(node);
+    }
+    std::vector<float> decrements(NODE_BATCH);
+    for (int i = 0; i < NODE_BATCH; i++) {
+        decrements[i] = (float)rand() / RAND_MAX;
+    }
+
+    return measure([&](long long* count) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NODE_BATCH; i++) {
+            TreeNode* node = pq.top();
+            pq.pop();
+            node->bound -= decrements[i];
+            pq.push(node);
+        }
+        double seconds = seconds_since(start);
+        sink = pq.top()->bound;
+        *count += NODE_BATCH;
+        return seconds;
+    }, config.repeats, config.min_time, ops);
+}
+
+void emit(const MicroResult& result, const std::string& timestamp, std::vector<MicroResult>* results,
+          std::ofstream* csv) {
+    char row[512];
+    snprintf(row, sizeof(row), "%s,%s,%s,%d,%d,%s,%d,%lld,%.3f,%.3f,%.3f,%.3f\n",
+             timestamp.c_str(), result.kernel.c_str(), result.distribution.c_str(),
+             result.n, result.queue_size, result.unit, result.ns.runs, result.ops,
+             result.ns.min, result.ns.median, result.ns.p95, result.ns.stddev);
+    fputs(row, stdout);
+    fflush(stdout);
+    if (csv->is_open()) {
+        *csv << row;
+    }
+    results->push_back(result);
+}
+
+const char* CSV_HEADER =
+    "timestamp,kernel,distribution,n,queue_size,unit,repeats,ops,"
+    "ns_min,ns_median,ns_p95,ns_stddev\n";
+
+bool write_json(const std::string& filename, const std::string& timestamp,
+                const std::vector<MicroResult>& results) {
+    std::ofstream out(filename.c_str());
+    if (!out.is_open()) {
+        printf("Warning: Could not open %s for writing\n", filename.c_str());
+        return false;
+    }
+    out.precision(9);
+    out << "[\n";
+    for (size_t r = 0; r < results.size(); r++) {
+        const MicroResult& result = results[r];
+        out << "  {\"timestamp\": ";
+        write_json_string(out, timestamp);
+        out << ", \"kernel\": ";
+        write_json_string(out, result.kernel);
+        out << ", \"distribution\": ";
+        write_json_string(out, result.distribution);
+        out << ", \"n\": " << result.n
+            << ", \"queue_size\": " << result.queue_size
+            << ", \"unit\": ";
+        write_json_string(out, result.unit);
+        out << ", \"repeats\": " << result.ns.runs
+            << ", \"ops\": " << result.ops
+            << ",\n   \"ns_min\": " << result.ns.min
+            << ", \"ns_median\": " << result.ns.median
+            << ", \"ns_p95\": " << result.ns.p95
+            << ", \"ns_stddev\": " << result.ns.stddev
+            << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    out.close();
+    if (out.fail()) {
+        printf("Warning: Could not write %s\n", filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MicroConfig config;
+    if (!parse_args(argc, argv, &config)) {
+        return 1;
+    }
+
+    char timestamp[32];
+    time_t now = time(nullptr);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    std::ofstream csv;
+    if (!config.csv_file.empty()) {
+        bool empty = true;
+        {
+            std::ifstream existing(config.csv_file.c_str());
+            empty = !existing.is_open() || existing.peek() == std::ifstream::traits_type::eof();
+        }
+        csv.open(config.csv_file.c_str(), std::ios::app);
+        if (!csv.is_open()) {
+            printf("Error: Could not open %s for writing\n", config.csv_file.c_str());
+            return 1;
+        }
+        if (empty) {
+            csv << CSV_HEADER;
+        }
+    }
+
+    fputs(CSV_HEADER, stdout);
+    std::vector<MicroResult> results;
+    for (size_t s = 0; s < config.sizes.size(); s++) {
+        int n = config.sizes[s];
+        for (size_t d = 0; d < config.distributions.size(); d++) {
+            const char* distribution = config.distributions[d].c_str();
+            Instance instance(n);
+            build_instance(distribution, n, config, &instance);
+
+            MicroResult result;
+            result.distribution = distribution;
+            result.n = n;
+            result.queue_size = 0;
+            for (size_t k = 0; k < config.kernels.size(); k++) {
+                const std::string& kernel = config.kernels[k];
+                std::vector<double> ns;
+                if (kernel == "bound_reference") {
+                    int count = (int)instance.items.size();
+                    ns = measure([&](long long* ops) {
+                        return bound_batch(&instance, [&](TreeNode* node) {
+                            return calculate_bound(node, instance.items.data(), count,
+                                                   instance.capacity);
+                        }, ops);
+                    }, config.repeats, config.min_time, &result.ops);
+                    result.unit = "bound";
+                } else if (kernel == "bound_dantzig") {
+                    ns = measure_policy<DantzigBound>(&instance, config, &result.ops);
+                    result.unit = "bound";
+                } else if (kernel == "bound_mt2") {
+                    ns = measure_policy<MartelloTothBound>(&instance, config, &result.ops);
+                    result.unit = "bound";
+                } else if (kernel == "bound_mm") {
+                    ns = measure_policy<MullerMerbachBound>(&instance, config, &result.ops);
+                    result.unit = "bound";
+                } else if (kernel == "sort_items" || kernel == "sort_compare_items") {
+                    ns = measure_sort(instance, kernel == "sort_items", config, &result.ops);
+                    result.unit = "item";
+                } else {
+                    continue;
+                }
+                result.kernel = kernel;
+                result.ns = summarize_timings(ns);
+                emit(result, timestamp, &results, &csv);
+            }
+
+            // Kernels that do not depend on the item values, once per n
+            if (d > 0) {
+                continue;
+            }
+            result.distribution = "-";
+            if (contains(config.kernels, "node_add")) {
+                std::vector<double> ns = measure_node_add(&instance, config, &result.ops);
+                result.kernel = "node_add";
+                result.unit = "node";
+                result.ns = summarize_timings(ns);
+                emit(result, timestamp, &results, &csv);
+            }
+            if (contains(config.kernels, "heap")) {
+                for (size_t q = 0; q < config.queue_sizes.size(); q++) {
+                    int queue_size = config.queue_sizes[q];
+                    if ((size_t)queue_size * TreeNode::bytes_for(n) > HEAP_MAX_BYTES) {
+                        fprintf(stderr, "Skipping heap with %d nodes of %d items (over %zu MiB)\n",
+                                queue_size, n, HEAP_MAX_BYTES >> 20);
+                        continue;
+                    }
+                    std::vector<double> ns = measure_heap(n, queue_size, config, &result.ops);
+                    result.kernel = "heap";
+                    result.unit = "pop+push";
+                    result.queue_size = queue_size;
+                    result.ns = summarize_timings(ns);
+                    emit(result, timestamp, &results, &csv);
+                }
+                result.queue_size = 0;
+            }
+        }
+    }
+
+    if (!config.json_file.empty() && write_json(config.json_file, timestamp, results)) {
+        fprintf(stderr, "Results written to %s\n", config.json_file.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include "benchmark_harness.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+
+namespace {
+
+// Whether parse_benchmark_args prints what is wrong with the command line
+bool report_errors = true;
+
+void print_error(const char* format, ...) {
+    if (!report_errors) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+} // namespace
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            out << '\\' << (char)c;
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << (char)c;
+        }
+    }
+    out << '"';
+}
+
+std::vector<std::string> split_list(const char* text) {
+    std::vector<std::string> parts;
+    std::string current;
+    for (const char* c = text; ; c++) {
+        if (*c == ',' || *c == '\0') {
+            if (!current.empty()) {
+                parts.push_back(current);
+            }
+            current.clear();
+            if (*c == '\0') {
+                break;
+            }
+        } else {
+            current += *c;
+        }
+    }
+    return parts;
+}
+
+bool parse_count(const char* text, int minimum, int* out) {
+    char* end = nullptr;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < minimum || value > INT_MAX) {
+        return false;
+    }
+    *out = (int)value;
+    return true;
+}
+
+BenchmarkConfig::BenchmarkConfig()
+    : engines(1, "sequential"), iterations(10), warmup(1),
+      results_dir("results"), verbose(false), frontier_budget_mb(0.0),
+      fix_variables(true) {}
+
+BenchmarkResult::BenchmarkResult()
+    : processes(0), threads(0), warmup(0), nodes_explored(0), nodes_pruned(0),
+      optimal_value(0.0f) {
+    memset(&timing, 0, sizeof(timing));
+}
+
+void print_benchmark_usage(const char* program) {
+    printf("Usage: %s [options] <dataset>...\n", program);
+    printf("\nOptions:\n");
+    printf("  -e, --engines LIST     Implementations to run, comma-separated (default: sequential)\n");
+    printf("                         sequential, sequential_<engine> (bnb_mt2, bnb_mm, bnb_fixed,\n");
+    printf("                         dp, subset, pareto, mitm), openmp, openmp_tasks, openmp_multiqueue\n");
+    printf("  -t, --threads LIST     Thread counts, comma-separated (default: 1; hybrid: all cores)\n");
+    printf("  -i, --iterations N     Timed runs per configuration (default: 10)\n");
+    printf("  -w, --warmup N         Untimed runs before them (default: 1)\n");
+    printf("      --results DIR      Append CSV rows to DIR/<implementation>_benchmarks.csv (default: results)\n");
+    printf("      --no-csv           Do not write CSV rows\n");
+    printf("      --json FILE        Also write all results to FILE as JSON\n");
+    printf("      --budget MIB       Frontier memory budget for sequential engines (default: unlimited)\n");
+    printf("      --no-fix           Disable reduced-cost variable fixing\n");
+    printf("      --trace FILE       Write the incumbent trace of the last OpenMP run to FILE (CSV)\n");
+    printf("  -v, --verbose          Keep the engines' progress output\n");
+    printf("\nExample: %s -e sequential,openmp -t 1,2,4 -i 20 data/85.txt data/121.txt\n", program);
+}
+
+bool parse_benchmark_args(int argc, char* argv[], BenchmarkConfig* config,
+                          bool print_errors) {
+    report_errors = print_errors;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (arg[0] != '-') {
+            config->datasets.push_back(arg);
+            continue;
+        }
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            if (print_errors) {
+                print_benchmark_usage(argv[0]);
+            }
+            return false;
+        }
+        if (strcmp(arg, "--no-csv") == 0) {
+            config->results_dir.clear();
+            continue;
+        }
+        if (strcmp(arg, "--no-fix") == 0) {
+            config->fix_variables = false;
+            continue;
+        }
+        if (strcmp(arg, "-v") == 0 || strcmp(arg, "--verbose") == 0) {
+            config->verbose = true;
+            continue;
+        }
+
+        // Every other option takes a value
+        if (i + 1 >= argc) {
+            print_error("Error: Option %s needs a value\n", arg);
+            return false;
+        }
+        const char* value = argv[++i];
+        if (strcmp(arg, "-e") == 0 || strcmp(arg, "--engines") == 0) {
+            config->engines = split_list(value);
+            if (config->engines.empty()) {
+                print_error("Error: No engine given\n");
+                return false;
+            }
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            std::vector<std::string> parts = split_list(value);
+            config->thread_counts.clear();
+            for (size_t k = 0; k < parts.size(); k++) {
+                int threads = 0;
+                if (!parse_count(parts[k].c_str(), 1, &threads)) {
+                    print_error("Error: Thread count must be >= 1, got '%s'\n", parts[k].c_str());
+                    return false;
+                }
+                config->thread_counts.push_back(threads);
+            }
+            if (config->thread_counts.empty()) {
+                print_error("Error: No thread count given\n");
+                return false;
+            }
+        } else if (strcmp(arg, "-i") == 0 || strcmp(arg, "--iterations") == 0) {
+            if (!parse_count(value, 1, &config->iterations)) {
+                print_error("Error: Iterations must be >= 1, got '%s'\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "-w") == 0 || strcmp(arg, "--warmup") == 0) {
+            if (!parse_count(value, 0, &config->warmup)) {
+                print_error("Error: Warm-up runs must be >= 0, got '%s'\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "--results") == 0) {
+            config->results_dir = value;
+        } else if (strcmp(arg, "--json") == 0) {
+            config->json_file = value;
+        } else if (strcmp(arg, "--trace") == 0) {
+            config->trace_file = value;
+        } else if (strcmp(arg, "--budget") == 0) {
+            char* end = nullptr;
+            config->frontier_budget_mb = strtod(value, &end);
+            if (end == value || *end != '\0' || config->frontier_budget_mb < 0.0) {
+                print_error("Error: Frontier budget must be >= 0 MiB, got '%s'\n", value);
+                return false;
+            }
+        } else {
+            print_error("Error: Unknown option %s (see --help)\n", arg);
+            return false;
+        }
+    }
+
+    if (config->datasets.empty()) {
+        print_error("Error: No dataset given (see --help)\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Computes total, mean, min, median, nearest-rank 95th percentile and
+ * sample standard deviation of the run times.
+ *
+ * @param seconds Run times in seconds
+ * @return The summary (all zero for an empty list)
+ */
+TimingSummary summarize_timings(const std::vector<double>& seconds) {
+    TimingSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    int runs = (int)seconds.size();
+    if (runs == 0) {
+        return summary;
+    }
+
+    std::vector<double> sorted(seconds);
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (int i = 0; i < runs; i++) {
+        total += sorted[i];
+    }
+    double mean = total / runs;
+    double squares = 0.0;
+    for (int i = 0; i < runs; i++) {
+        squares += (sorted[i] - mean) * (sorted[i] - mean);
+    }
+
+    summary.runs = runs;
+    summary.total = total;
+    summary.mean = mean;
+    summary.min = sorted[0];
+    summary.median = runs % 2 == 1 ? sorted[runs / 2]
+                                   : 0.5 * (sorted[runs / 2 - 1] + sorted[runs / 2]);
+    summary.p95 = sorted[(int)ceil(0.95 * runs) - 1];
+    summary.stddev = runs > 1 ? sqrt(squares / (runs - 1)) : 0.0;
+    return summary;
+}
+
+std::string dataset_name(const std::string& path) {
+    size_t last_slash = path.find_last_of("/");
+    return last_slash == std::string::npos ? path : path.substr(last_slash + 1);
+}
+
+void print_benchmark_result(const BenchmarkResult& result) {
+    const TimingSummary& t = result.timing;
+    printf("%-24s %-20s", result.dataset.c_str(), result.implementation.c_str());
+    if (result.processes > 0) {
+        printf(" %3d proc", result.processes);
+    }
+    if (result.threads > 0) {
+        printf(" %3d thr", result.threads);
+    }
+    printf("  min %9.3f  median %9.3f  p95 %9.3f  stddev %8.3f ms  value %.2f\n",
+           t.min * 1000.0, t.median * 1000.0, t.p95 * 1000.0, t.stddev * 1000.0,
+           result.optimal_value);
+}
+
+bool append_benchmark_csv(const std::string& results_dir, const BenchmarkResult& result) {
+    if (mkdir(results_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        printf("Warning: Could not create directory %s\n", results_dir.c_str());
+        return false;
+    }
+    std::string csv_file = results_dir + "/" + result.implementation + "_benchmarks.csv";
+    bool empty = true;
+    {
+        std::ifstream existing(csv_file.c_str());
+        empty = !existing.is_open() || existing.peek() == std::ifstream::traits_type::eof();
+    }
+
+    std::ofstream csv(csv_file.c_str(), std::ios::app);
+    if (!csv.is_open()) {
+        printf("Warning: Could not open %s for writing\n", csv_file.c_str());
+        return false;
+    }
+
+    const char* workers = result.processes == 0 ? "threads"
+                        : result.threads == 0   ? "processes"
+                                                : "processes,threads";
+    if (empty) {
+        csv << "dataset,implementation," << workers << ",iterations,total_time_sec,"
+            << "avg_time_sec,nodes_explored,nodes_pruned,optimal_value\n";
+    }
+
+    csv << result.dataset << "," << result.implementation << ",";
+    if (result.processes > 0) {
+        csv << result.processes << ",";
+    }
+    if (result.processes == 0 || result.threads > 0) {
+        csv << result.threads << ",";
+    }
+    csv << result.timing.runs << ","
+        << result.timing.total << "," << result.timing.mean << ","
+        << result.nodes_explored << "," << result.nodes_pruned << ","
+        << result.optimal_value << "\n";
+    return true;
+}
+
+bool write_benchmark_json(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(filename.c_str());
+    if (!out.is_open()) {
+        printf("Warning: Could not open %s for writing\n", filename.c_str());
+        return false;
+    }
+    out.precision(9);
+
+    out << "[\n";
+    for (size_t r = 0; r < results.size(); r++) {
+        const BenchmarkResult& result = results[r];
+        const TimingSummary& t = result.timing;
+        out << "  {\"dataset\": ";
+        write_json_string(out, result.dataset);
+        out << ", \"implementation\": ";
+        write_json_string(out, result.implementation);
+        out << ", \"processes\": " << result.processes
+            << ", \"threads\": " << result.threads
+            << ", \"iterations\": " << t.runs
+            << ", \"warmup\": " << result.warmup
+            << ",\n   \"total_time_sec\": " << t.total
+            << ", \"avg_time_sec\": " << t.mean
+            << ", \"min_time_sec\": " << t.min
+            << ", \"median_time_sec\": " << t.median
+            << ", \"p95_time_sec\": " << t.p95
+            << ", \"stddev_time_sec\": " << t.stddev
+            << ",\n   \"times_sec\": [";
+        for (size_t i = 0; i < result.seconds.size(); i++) {
+            out << (i > 0 ? ", " : "") << result.seconds[i];
+        }
+        out << "],\n   \"nodes_explored\": " << result.nodes_explored
+            << ", \"nodes_pruned\": " << result.nodes_pruned
+            << ", \"optimal_value\": " << result.optimal_value
+            << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+
+    out.close();
+    if (out.fail()) {
+        printf("Warning: Could not write %s\n", filename.c_str());
+        return false;
+    }
+    return true;
+}
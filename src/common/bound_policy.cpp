@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <float.h>
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include "bound_policy.h"
+#include "output_display.h"
+
+namespace {
+
+// Items scanned between checks of the Mueller-Merbach early exit
+const int FLIP_BLOCK = 64;
+
+// Room by which an item may seem not to fit and still fit the search.
+// The search adds weights in float, the fill uses double prefix sums, so
+// an item that exactly fills the knapsack can land on either side
+inline double fit_slack(const PrefixBound& prefix) {
+    return (double)prefix.capacity() * BOUND_TOLERANCE;
+}
+
+/**
+ * Mueller-Merbach flip kernels. Over items [lo, hi) they raise `gain`, the
+ * best gain over the greedy value P (see MullerMerbachBound::bound), to
+ *   drop:  max (r + w[j]) * critical - p[j]
+ *   add:   max p[j] + max(r - w[j], 0) * critical  if r - w[j] >= -slack
+ *              p[j] + (r - w[j]) * below           otherwise
+ * and stop at the first FLIP_BLOCK boundary where it reaches `enough`.
+ * below is DBL_MAX when no item precedes the critical one, which sends
+ * items that cannot fit to -inf. Sums are in double, as in the fill.
+ *
+ * The block loop lives inside the kernels: returning from vector code to
+ * the scalar caller has a cost, so a scan enters it only once.
+ */
+struct FlipTerms {
+    double residual;
+    double critical;
+    double below;
+    double slack;
+};
+
+typedef double (*FlipKernel)(const float* weight, const float* value, int lo, int hi,
+                             const FlipTerms& t, double gain, double enough);
+
+inline double drop_gain(float weight, float value, const FlipTerms& t) {
+    return (t.residual + weight) * t.critical - value;
+}
+
+inline double add_gain(float weight, float value, const FlipTerms& t) {
+    double room = t.residual - weight;
+    return room >= -t.slack ? value + std::max(room, 0.0) * t.critical
+                            : value + room * t.below;
+}
+
+double drop_kernel_scalar(const float* weight, const float* value, int lo, int hi,
+                          const FlipTerms& t, double gain, double enough) {
+    for (int j = lo; j < hi && gain < enough; j++) {
+        gain = std::max(gain, drop_gain(weight[j], value[j], t));
+    }
+    return gain;
+}
+
+double add_kernel_scalar(const float* weight, const float* value, int lo, int hi,
+                         const FlipTerms& t, double gain, double enough) {
+    for (int j = lo; j < hi && gain < enough; j++) {
+        gain = std::max(gain, add_gain(weight[j], value[j], t));
+    }
+    return gain;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+inline double horizontal_max(__m256d v) {
+    __m128d m = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return std::max(_mm_cvtsd_f64(m), _mm_cvtsd_f64(_mm_unpackhi_pd(m, m)));
+}
+
+// AVX2: four items per instruction, floats widened to double on load
+__attribute__((target("avx2,fma")))
+double drop_kernel_avx2(const float* weight, const float* value, int lo, int hi,
+                        const FlipTerms& t, double gain, double enough) {
+    const __m256d residual = _mm256_set1_pd(t.residual);
+    const __m256d critical = _mm256_set1_pd(t.critical);
+    int j = lo;
+    while (j < hi && gain < enough) {
+        int end = std::min(hi, j + FLIP_BLOCK);
+        __m256d best = _mm256_set1_pd(gain);
+        for (; j + 4 <= end; j += 4) {
+            __m256d w = _mm256_cvtps_pd(_mm_loadu_ps(weight + j));
+            __m256d p = _mm256_cvtps_pd(_mm_loadu_ps(value + j));
+            best = _mm256_max_pd(best, _mm256_fmsub_pd(_mm256_add_pd(residual, w), critical, p));
+        }
+        gain = horizontal_max(best);
+        for (; j < end; j++) {
+            gain = std::max(gain, drop_gain(weight[j], value[j], t));
+        }
+    }
+    return gain;
+}
+
+__attribute__((target("avx2,fma")))
+double add_kernel_avx2(const float* weight, const float* value, int lo, int hi,
+                       const FlipTerms& t, double gain, double enough) {
+    const __m256d residual = _mm256_set1_pd(t.residual);
+    const __m256d critical = _mm256_set1_pd(t.critical);
+    const __m256d below = _mm256_set1_pd(t.below);
+    const __m256d min_room = _mm256_set1_pd(-t.slack);
+    const __m256d zero = _mm256_setzero_pd();
+    int j = lo;
+    while (j < hi && gain < enough) {
+        int end = std::min(hi, j + FLIP_BLOCK);
+        __m256d best = _mm256_set1_pd(gain);
+        for (; j + 4 <= end; j += 4) {
+            __m256d w = _mm256_cvtps_pd(_mm_loadu_ps(weight + j));
+            __m256d p = _mm256_cvtps_pd(_mm_loadu_ps(value + j));
+            __m256d room = _mm256_sub_pd(residual, w);
+            __m256d fits = _mm256_cmp_pd(room, min_room, _CMP_GE_OQ);
+            __m256d filled = _mm256_fmadd_pd(_mm256_max_pd(room, zero), critical, p);
+            __m256d freed = _mm256_fmadd_pd(room, below, p);
+            best = _mm256_max_pd(best, _mm256_blendv_pd(freed, filled, fits));
+        }
+        gain = horizontal_max(best);
+        for (; j < end; j++) {
+            gain = std::max(gain, add_gain(weight[j], value[j], t));
+        }
+    }
+    return gain;
+}
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+// NEON: two items per instruction (always available on AArch64)
+double drop_kernel_neon(const float* weight, const float* value, int lo, int hi,
+                        const FlipTerms& t, double gain, double enough) {
+    const float64x2_t residual = vdupq_n_f64(t.residual);
+    const float64x2_t critical = vdupq_n_f64(t.critical);
+    int j = lo;
+    while (j < hi && gain < enough) {
+        int end = std::min(hi, j + FLIP_BLOCK);
+        float64x2_t best = vdupq_n_f64(gain);
+        for (; j + 2 <= end; j += 2) {
+            float64x2_t w = vcvt_f64_f32(vld1_f32(weight + j));
+            float64x2_t p = vcvt_f64_f32(vld1_f32(value + j));
+            best = vmaxq_f64(best, vsubq_f64(vmulq_f64(vaddq_f64(residual, w), critical), p));
+        }
+        gain = vmaxvq_f64(best);
+        for (; j < end; j++) {
+            gain = std::max(gain, drop_gain(weight[j], value[j], t));
+        }
+    }
+    return gain;
+}
+
+double add_kernel_neon(const float* weight, const float* value, int lo, int hi,
+                       const FlipTerms& t, double gain, double enough) {
+    const float64x2_t residual = vdupq_n_f64(t.residual);
+    const float64x2_t critical = vdupq_n_f64(t.critical);
+    const float64x2_t below = vdupq_n_f64(t.below);
+    const float64x2_t min_room = vdupq_n_f64(-t.slack);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    int j = lo;
+    while (j < hi && gain < enough) {
+        int end = std::min(hi, j + FLIP_BLOCK);
+        float64x2_t best = vdupq_n_f64(gain);
+        for (; j + 2 <= end; j += 2) {
+            float64x2_t w = vcvt_f64_f32(vld1_f32(weight + j));
+            float64x2_t p = vcvt_f64_f32(vld1_f32(value + j));
+            float64x2_t room = vsubq_f64(residual, w);
+            uint64x2_t fits = vcgeq_f64(room, min_room);
+            float64x2_t filled = vfmaq_f64(p, vmaxq_f64(room, zero), critical);
+            float64x2_t freed = vfmaq_f64(p, room, below);
+            best = vmaxq_f64(best, vbslq_f64(fits, filled, freed));
+        }
+        gain = vmaxvq_f64(best);
+        for (; j < end; j++) {
+            gain = std::max(gain, add_gain(weight[j], value[j], t));
+        }
+    }
+    return gain;
+}
+#endif
+
+struct FlipKernels {
+    FlipKernel drop;
+    FlipKernel add;
+};
+
+FlipKernels select_flip_kernels() {
+    FlipKernels kernels = { drop_kernel_scalar, add_kernel_scalar };
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        kernels.drop = drop_kernel_avx2;
+        kernels.add = add_kernel_avx2;
+    }
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    kernels.drop = drop_kernel_neon;
+    kernels.add = add_kernel_neon;
+#endif
+    return kernels;
+}
+
+// Chosen once, on first use
+const FlipKernels& flip_kernels() {
+    static const FlipKernels kernels = select_flip_kernels();
+    return kernels;
+}
+
+} // namespace
+
+/**
+ * Prints the policy name and how many nodes its bound pruned.
+ */
+void BoundPolicy::report() const {
+    print_info("Bound policy: %s, nodes pruned by bound: %lld\n", name_, pruned_);
+}
+
+/**
+ * Calculates the Martello-Toth U2 bound from a greedy fill.
+ *
+ * With P the value of the whole items, r the room left and s the critical
+ * item:
+ *   U0 = P + r * p[s+1]/w[s+1]                 (s excluded)
+ *   U1 = P + p[s] - (w[s] - r) * p[s-1]/w[s-1] (s included)
+ * and U2 = max(U0, U1). If s is the first free item it cannot be included
+ * at all, so only U0 applies, unless it misses the room only by float
+ * rounding; then the Dantzig bound is used.
+ *
+ * @param f Greedy fill of the node
+ * @return U2 (equals the node value plus all free items if everything fits)
+ */
+double MartelloTothBound::u2(const PrefixBound::Fill& f) const {
+    const int n = prefix_.size();
+    const int s = f.critical;
+    if (s >= n) {
+        return f.value;
+    }
+
+    double exclude = f.value;
+    if (s + 1 < n) {
+        exclude += f.residual * prefix_.ratio(s + 1);
+    }
+
+    const float* weight = prefix_.columns().weight();
+    const float* value = prefix_.columns().value();
+    double include = -DBL_MAX;
+    if (s > f.first) {
+        include = f.value + value[s]
+                  - (weight[s] - f.residual) * prefix_.ratio(s - 1);
+    } else if (weight[s] <= f.residual + fit_slack(prefix_)) {
+        include = f.value + f.residual * prefix_.ratio(s);
+    }
+    return std::max(exclude, include);
+}
+
+/**
+ * Calculates the U2 bound for a search node, using and updating its cached
+ * critical index.
+ *
+ * @param node Current node in the search tree
+ * @return Upper bound on value for this branch
+ */
+float MartelloTothBound::bound(TreeNode* node) const {
+    // If we've exceeded capacity, this branch is infeasible
+    if (node->t_weight >= prefix_.capacity()) {
+        return 0.0f;
+    }
+    PrefixBound::Fill f = prefix_.fill(node->level, node->t_weight, node->t_value,
+                                       &node->critical);
+    return (float)u2(f);
+}
+
+/**
+ * Calculates the Mueller-Merbach bound for a search node.
+ *
+ * The greedy prefix (items [first, s) in, the rest out) is worth P. Any
+ * other solution flips some free item j != s:
+ *   j < s (dropped): P - p[j] + (r + w[j]) * p[s]/w[s]
+ *   j > s (added):   P + p[j] + (r - w[j]) * p[s]/w[s]      if w[j] <= r
+ *                    P + p[j] + (r - w[j]) * p[s-1]/w[s-1]  otherwise
+ * since the room left (or lacking) is filled (or freed) at the critical
+ * ratio at best. Adding j is infeasible if it does not fit and no greedy
+ * item can make room. Both scans run in the flip kernels, a block at a
+ * time.
+ *
+ * @param node Current node in the search tree
+ * @return min(U2, Mueller-Merbach)
+ */
+float MullerMerbachBound::bound(TreeNode* node) const {
+    if (node->t_weight >= prefix_.capacity()) {
+        return 0.0f;
+    }
+    PrefixBound::Fill f = prefix_.fill(node->level, node->t_weight, node->t_value,
+                                       &node->critical);
+    const int n = prefix_.size();
+    const int s = f.critical;
+    double upper = u2(f);
+    // If s fits up to float rounding the fill is integral and U2 is exact
+    if (s >= n || prefix_.columns().weight()[s] <= f.residual + fit_slack(prefix_)) {
+        return (float)upper;
+    }
+
+    FlipTerms terms;
+    terms.residual = f.residual;
+    terms.critical = prefix_.ratio(s);
+    terms.below = s > f.first ? prefix_.ratio(s - 1) : DBL_MAX;
+    terms.slack = fit_slack(prefix_);
+
+    // Stop as soon as a flip reaches U2: the minimum is then U2
+    const FlipKernels& kernels = flip_kernels();
+    const float* weight = prefix_.columns().weight();
+    const float* value = prefix_.columns().value();
+    const double enough = upper - f.value;
+    double gain = kernels.drop(weight, value, f.first, s, terms, 0.0, enough);
+    gain = kernels.add(weight, value, s + 1, n, terms, gain, enough);
+    return (float)std::min(f.value + gain, upper);
+}
@@ -0,0 +1,208 @@
+#include "dominance_table.h"
+#include "output_display.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+namespace {
+
+// Weight buckets per capacity: states closer than capacity / 2^16 share one
+const float WEIGHT_BUCKETS = 65536.0f;
+
+const int SLOTS = 4;
+
+// splitmix64 finalizer: spreads (level, weight bucket) over the table
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+/**
+ * Allocates and clears the buckets of every shard. The budget is split
+ * evenly over the shards and rounded down to a power of two buckets each.
+ *
+ * @param capacity Knapsack capacity
+ * @param budget_bytes Memory for the buckets (0 disables the table)
+ * @param num_shards Number of shards
+ */
+DominanceTable::DominanceTable(float capacity, size_t budget_bytes, int num_shards)
+    : shards_(nullptr),
+      num_shards_(num_shards < 1 ? 1 : num_shards),
+      buckets_per_shard_(0),
+      inverse_quantum_(capacity > 0.0f ? WEIGHT_BUCKETS / capacity : 1.0f) {
+    size_t per_shard = budget_bytes / num_shards_ / sizeof(Bucket);
+    if (per_shard == 0) {
+        return;
+    }
+    buckets_per_shard_ = 1;
+    while (buckets_per_shard_ * 2 <= per_shard) {
+        buckets_per_shard_ *= 2;
+    }
+
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 64, sizeof(Shard) * num_shards_) != 0) {
+        throw std::bad_alloc();
+    }
+    shards_ = static_cast<Shard*>(memory);
+    for (int s = 0; s < num_shards_; s++) {
+        Shard* shard = new (&shards_[s]) Shard();
+        shard->dominated.store(0);
+        shard->evictions.store(0);
+        if (posix_memalign(&memory, 64, sizeof(Bucket) * buckets_per_shard_) != 0) {
+            throw std::bad_alloc();
+        }
+        shard->buckets = static_cast<Bucket*>(memory);
+        for (size_t b = 0; b < buckets_per_shard_; b++) {
+            Bucket* bucket = new (&shard->buckets[b]) Bucket();
+            for (int i = 0; i < SLOTS; i++) {
+                bucket->slots[i].version.store(0, std::memory_order_relaxed);
+                bucket->slots[i].level.store(-1, std::memory_order_relaxed);
+                bucket->slots[i].weight.store(0.0f, std::memory_order_relaxed);
+                bucket->slots[i].value.store(0.0f, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+DominanceTable::~DominanceTable() {
+    if (!shards_) {
+        return;
+    }
+    for (int s = 0; s < num_shards_; s++) {
+        free(shards_[s].buckets);
+    }
+    free(shards_);
+}
+
+/**
+ * Reads a slot consistently: the version is unchanged and even around the
+ * field loads, otherwise a writer was active and the slot counts as empty.
+ */
+bool DominanceTable::read(const Slot& slot, int* level, float* weight, float* value) {
+    uint32_t before = slot.version.load(std::memory_order_acquire);
+    if (before & 1u) {
+        return false;
+    }
+    *level = slot.level.load(std::memory_order_relaxed);
+    *weight = slot.weight.load(std::memory_order_relaxed);
+    *value = slot.value.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint32_t after = slot.version.load(std::memory_order_relaxed);
+    return before == after && *level >= 0;
+}
+
+/**
+ * Claims a slot by making its version odd, writes it and releases it with
+ * the next even version. If another thread holds the slot the state is
+ * simply not recorded.
+ */
+void DominanceTable::write(Slot& slot, int level, float weight, float value) {
+    uint32_t version = slot.version.load(std::memory_order_relaxed);
+    if ((version & 1u) ||
+        !slot.version.compare_exchange_strong(version, version + 1,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.level.store(level, std::memory_order_relaxed);
+    slot.weight.store(weight, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+DominanceTable::Bucket& DominanceTable::bucket(int level, int64_t quantized, Shard** shard) {
+    uint64_t hash = mix(((uint64_t)(uint32_t)level << 40) ^ (uint64_t)quantized);
+    *shard = &shards_[(hash >> 32) % (uint64_t)num_shards_];
+    return (*shard)->buckets[hash & (buckets_per_shard_ - 1)];
+}
+
+/**
+ * Rejects a state dominated by a recorded state at its level, looking in
+ * its own weight bucket and the next lighter one; otherwise records the
+ * state in its own bucket.
+ *
+ * @param level Last decided item index of the node
+ * @param weight Total weight of the node
+ * @param value Total value of the node
+ * @return false if the state is dominated
+ */
+bool DominanceTable::admit(int level, float weight, float value) {
+    if (!enabled()) {
+        return true;
+    }
+
+    const int64_t quantized = (int64_t)(weight * inverse_quantum_);
+
+    Shard* shard = nullptr;
+    int slot_level;
+    float slot_weight;
+    float slot_value;
+    for (int64_t q = quantized; q >= quantized - 1; q--) {
+        Bucket& lookup = bucket(level, q, &shard);
+        for (int i = 0; i < SLOTS; i++) {
+            if (read(lookup.slots[i], &slot_level, &slot_weight, &slot_value) &&
+                slot_level == level && slot_weight <= weight && slot_value >= value) {
+                shard->dominated.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+    }
+
+    // Victim: an empty slot, else a state this node dominates, else the
+    // deepest state in the bucket
+    Bucket& home = bucket(level, quantized, &shard);
+    int victim = -1;
+    int deepest = 0;
+    int deepest_level = -1;
+    for (int i = 0; i < SLOTS && victim < 0; i++) {
+        if (!read(home.slots[i], &slot_level, &slot_weight, &slot_value)) {
+            victim = i;
+        } else if (slot_level == level && weight <= slot_weight && value >= slot_value) {
+            victim = i;
+        } else if (slot_level > deepest_level) {
+            deepest = i;
+            deepest_level = slot_level;
+        }
+    }
+    if (victim < 0) {
+        victim = deepest;
+        shard->evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    write(home.slots[victim], level, weight, value);
+    return true;
+}
+
+long long DominanceTable::dominated() const {
+    long long total = 0;
+    for (int s = 0; s < num_shards_ && shards_; s++) {
+        total += shards_[s].dominated.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long long DominanceTable::evictions() const {
+    long long total = 0;
+    for (int s = 0; s < num_shards_ && shards_; s++) {
+        total += shards_[s].evictions.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * Prints the table size and how many nodes it rejected and evicted.
+ */
+void DominanceTable::report() const {
+    if (!enabled()) {
+        return;
+    }
+    size_t bytes = buckets_per_shard_ * num_shards_ * sizeof(Bucket);
+    print_info("Dominance table: %.1f MiB, nodes dominated: %lld, evictions: %lld\n",
+               bytes / (1024.0 * 1024.0), dominated(), evictions());
+}
@@ -0,0 +1,80 @@
+#include "instance_generator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+// Random float between min and max
+float rand_range(float min, float max) {
+    return min + (float)rand() / RAND_MAX * (max - min);
+}
+
+void add_item(Dataset* dataset, float value, float weight) {
+    dataset->values.push_back(two_decimals(value));
+    dataset->weights.push_back(two_decimals(weight));
+    dataset->total_weight += weight;
+}
+
+} // namespace
+
+float two_decimals(float x) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.2f", x);
+    return strtof(text, NULL);
+}
+
+bool generate_items(int num_items, const char* distribution, Dataset* dataset) {
+    dataset->values.clear();
+    dataset->weights.clear();
+    dataset->values.reserve(num_items);
+    dataset->weights.reserve(num_items);
+    dataset->total_weight = 0.0f;
+
+    if (strcmp(distribution, "uncorrelated") == 0) {
+        // Uncorrelated: completely random values and weights
+        for (int i = 0; i < num_items; i++) {
+            float weight = rand_range(1.0f, 100.0f);
+            float value = rand_range(1.0f, 100.0f);
+            add_item(dataset, value, weight);
+        }
+
+    } else if (strcmp(distribution, "weakly_correlated") == 0) {
+        // Weakly correlated: value ≈ weight + noise
+        for (int i = 0; i < num_items; i++) {
+            float weight = rand_range(1.0f, 100.0f);
+            float value = weight + rand_range(-10.0f, 10.0f);
+            if (value < 1.0f) value = 1.0f; // Keep positive
+            add_item(dataset, value, weight);
+        }
+
+    } else if (strcmp(distribution, "strongly_correlated") == 0) {
+        // Strongly correlated: value = weight + constant
+        float constant = 10.0f;
+        for (int i = 0; i < num_items; i++) {
+            float weight = rand_range(1.0f, 100.0f);
+            float value = weight + constant;
+            add_item(dataset, value, weight);
+        }
+
+    } else if (strcmp(distribution, "subset_sum") == 0) {
+        // Subset sum: value = weight (hardest for branch & bound)
+        for (int i = 0; i < num_items; i++) {
+            float weight = rand_range(1.0f, 100.0f);
+            float value = weight; // Same as weight
+            add_item(dataset, value, weight);
+        }
+
+    } else if (strcmp(distribution, "inverse_strong") == 0) {
+        // Inverse strongly correlated: high value = low weight
+        for (int i = 0; i < num_items; i++) {
+            float weight = rand_range(1.0f, 100.0f);
+            float value = 100.0f - weight + rand_range(10.0f, 30.0f);
+            add_item(dataset, value, weight);
+        }
+
+    } else {
+        return false;
+    }
+    return true;
+}
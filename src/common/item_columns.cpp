@@ -0,0 +1,63 @@
+#include "item_columns.h"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+namespace {
+
+// Allocates a zeroed, 64-byte aligned column of `count` elements
+template <typename T>
+T* allocate_column(size_t count) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 64, count * sizeof(T)) != 0) {
+        throw std::bad_alloc();
+    }
+    memset(memory, 0, count * sizeof(T));
+    return static_cast<T*>(memory);
+}
+
+} // namespace
+
+/**
+ * Splits the items into aligned columns and precomputes their ratios.
+ *
+ * @param items Array of items (order is kept)
+ * @param n Number of items
+ */
+ItemColumns::ItemColumns(const Item* items, int n)
+    : n_(n), weight_(nullptr), value_(nullptr), ratio_(nullptr), id_(nullptr) {
+    size_t padded = ((size_t)n + ITEM_COLUMN_PAD - 1) / ITEM_COLUMN_PAD * ITEM_COLUMN_PAD;
+    if (padded == 0) {
+        padded = ITEM_COLUMN_PAD;
+    }
+    weight_ = allocate_column<float>(padded);
+    value_ = allocate_column<float>(padded);
+    ratio_ = allocate_column<float>(padded);
+    id_ = allocate_column<int>(padded);
+    for (int j = 0; j < n; j++) {
+        weight_[j] = items[j].weight;
+        value_[j] = items[j].value;
+        ratio_[j] = items[j].value / items[j].weight;
+        id_[j] = items[j].id;
+    }
+}
+
+ItemColumns::~ItemColumns() {
+    free(weight_);
+    free(value_);
+    free(ratio_);
+    free(id_);
+}
+
+/**
+ * Reassembles the Item array the columns were built from.
+ *
+ * @param out Output array with room for size() items
+ */
+void ItemColumns::to_items(Item* out) const {
+    for (int j = 0; j < n_; j++) {
+        out[j].id = id_[j];
+        out[j].value = value_[j];
+        out[j].weight = weight_[j];
+    }
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <vector>
 #include "knapsack_utils.h"
 
 /**
@@ -11,6 +13,37 @@ bool compare_items(const Item& a, const Item& b) {
     return a.value > b.value;
 }
 
+/**
+ * Sorts items by value-to-weight ratio in descending order, as
+ * std::sort with compare_items would. The ratios are computed once into
+ * sort keys instead of twice per comparison, and the items are moved
+ * into place in one pass at the end.
+ *
+ * @param items Array of items, sorted in place
+ * @param n Number of items
+ */
+void sort_items(Item* items, int n) {
+    struct SortKey {
+        float ratio;
+        float value;
+        int index;
+    };
+    std::vector<SortKey> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i].ratio = items[i].value / items[i].weight;
+        keys[i].value = items[i].value;
+        keys[i].index = i;
+    }
+    std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) {
+        if (a.ratio != b.ratio) return a.ratio > b.ratio;
+        return a.value > b.value;
+    });
+    std::vector<Item> original(items, items + n);
+    for (int i = 0; i < n; i++) {
+        items[i] = original[keys[i].index];
+    }
+}
+
 /**
  * Calculates the upper bound on maximum value achievable from a given node.
  * Uses fractional knapsack relaxation: greedily adds items until capacity is full,
@@ -18,6 +51,9 @@ bool compare_items(const Item& a, const Item& b) {
  * 
  * This bound is used for pruning: if bound <= current_best, the branch can be eliminated.
  * 
+ * This is the O(n) reference implementation; the solvers use PrefixBound,
+ * which computes the same bound from prefix sums in O(log n).
+ * 
  * @param node Current node in the search tree
  * @param items Array of items sorted by value/weight ratio
  * @param n Total number of items
@@ -48,4 +84,28 @@ float calculate_bound(TreeNode* node, Item* items, int n, float capacity) {
     }
     
     return bound;
+}
+
+/**
+ * Recovers a solution from the decision bits of a search node.
+ * Bit i of the bitset is set when sorted item i is in the knapsack, so the
+ * item set is read directly off the node without revisiting the tree.
+ * 
+ * @param decisions Packed include bits (TreeNode::decisions layout)
+ * @param items Array of items in the order the search used
+ * @param n Total number of items
+ * @param out Output array with room for n items
+ * @return Number of items written to out
+ */
+int collect_solution(const uint64_t* decisions, const Item* items, int n, Item* out) {
+    int count = 0;
+    for (int word = 0; word < TreeNode::decision_words(n); word++) {
+        uint64_t bits = decisions[word];
+        while (bits) {
+            int index = word * 64 + __builtin_ctzll(bits);
+            out[count++] = items[index];
+            bits &= bits - 1;
+        }
+    }
+    return count;
 }
\ No newline at end of file
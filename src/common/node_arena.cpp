@@ -0,0 +1,169 @@
+#include "node_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <sys/mman.h>
+
+namespace {
+
+// Regular slabs are 1 MiB; huge-page slabs match the 2 MiB huge page size.
+const size_t SLAB_BYTES = 1 << 20;
+const size_t HUGE_SLAB_BYTES = 2 << 20;
+
+// Slab header is padded so node blocks start on a cache line.
+const size_t SLAB_HEADER_BYTES = 64;
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+/**
+ * Creates an arena with num_pools independent pools. No slabs are mapped
+ * until the first allocation from a pool.
+ *
+ * @param num_pools Number of pools, normally one per worker thread
+ * @param node_bytes Size of each block (rounded up to 16 bytes)
+ * @param use_huge_pages Request huge page backing for slabs
+ */
+NodeArena::NodeArena(int num_pools, size_t node_bytes, bool use_huge_pages)
+    : pools_(nullptr),
+      num_pools_(num_pools < 1 ? 1 : num_pools),
+      node_bytes_(round_up(node_bytes < sizeof(FreeBlock) ? sizeof(FreeBlock) : node_bytes, 16)),
+      slab_bytes_(use_huge_pages ? HUGE_SLAB_BYTES : SLAB_BYTES),
+      use_huge_pages_(use_huge_pages) {
+    // Very large nodes still need at least a few blocks per slab
+    while (slab_bytes_ < SLAB_HEADER_BYTES + 16 * node_bytes_) {
+        slab_bytes_ *= 2;
+    }
+
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 64, sizeof(Pool) * num_pools_) != 0) {
+        throw std::bad_alloc();
+    }
+    pools_ = static_cast<Pool*>(memory);
+    for (int i = 0; i < num_pools_; i++) {
+        Pool& p = pools_[i];
+        p.head = nullptr;
+        p.current = nullptr;
+        p.cursor = nullptr;
+        p.limit = nullptr;
+        p.free_list = nullptr;
+        p.allocated = 0;
+    }
+}
+
+NodeArena::~NodeArena() {
+    release();
+    free(pools_);
+}
+
+char* NodeArena::slab_data(Slab* slab) {
+    return reinterpret_cast<char*>(slab) + SLAB_HEADER_BYTES;
+}
+
+/**
+ * Maps a fresh slab directly from the OS, bypassing malloc.
+ * With huge pages requested, explicit huge pages are tried first, then
+ * transparent huge pages are requested on a regular mapping.
+ */
+NodeArena::Slab* NodeArena::map_slab() {
+    void* memory = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (use_huge_pages_) {
+        memory = mmap(nullptr, slab_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+
+    if (memory == MAP_FAILED) {
+        memory = mmap(nullptr, slab_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            printf("Error: Node arena failed to map %zu bytes\n", slab_bytes_);
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (use_huge_pages_) {
+            madvise(memory, slab_bytes_, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    Slab* slab = static_cast<Slab*>(memory);
+    slab->next = nullptr;
+    slab->bytes = slab_bytes_;
+    return slab;
+}
+
+/**
+ * Moves a pool on to its next slab, reusing slabs kept from before the last
+ * reset() and mapping a new one only when the list is exhausted.
+ */
+void NodeArena::next_slab(Pool& p) {
+    Slab* slab = p.current ? p.current->next : p.head;
+    if (!slab) {
+        slab = map_slab();
+        if (p.current) {
+            p.current->next = slab;
+        } else {
+            p.head = slab;
+        }
+    }
+    p.current = slab;
+    p.cursor = slab_data(slab);
+    p.limit = reinterpret_cast<char*>(slab) + slab->bytes;
+}
+
+/**
+ * Bulk-frees every node of the search in O(num_pools): each pool is rewound
+ * to its first slab and its free list dropped. Slabs stay mapped, so a search
+ * repeated on the same arena does not touch the OS again.
+ */
+void NodeArena::reset() {
+    for (int i = 0; i < num_pools_; i++) {
+        Pool& p = pools_[i];
+        p.current = nullptr;
+        p.cursor = nullptr;
+        p.limit = nullptr;
+        p.free_list = nullptr;
+        p.allocated = 0;
+    }
+}
+
+/**
+ * Returns every slab to the OS.
+ */
+void NodeArena::release() {
+    for (int i = 0; i < num_pools_; i++) {
+        Pool& p = pools_[i];
+        Slab* slab = p.head;
+        while (slab) {
+            Slab* next = slab->next;
+            munmap(slab, slab->bytes);
+            slab = next;
+        }
+        p.head = nullptr;
+    }
+    reset();
+}
+
+size_t NodeArena::nodes_allocated() const {
+    size_t total = 0;
+    for (int i = 0; i < num_pools_; i++) {
+        total += pools_[i].allocated;
+    }
+    return total;
+}
+
+size_t NodeArena::bytes_mapped() const {
+    size_t total = 0;
+    for (int i = 0; i < num_pools_; i++) {
+        for (Slab* slab = pools_[i].head; slab; slab = slab->next) {
+            total += slab->bytes;
+        }
+    }
+    return total;
+}
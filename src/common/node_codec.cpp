@@ -0,0 +1,48 @@
+#include "node_codec.h"
+
+/**
+ * Appends the compact record of a node to a message buffer.
+ *
+ * @param node Node to encode
+ * @param words Decision words per node (TreeNode::decision_words(n))
+ * @param buffer Message buffer the record is appended to
+ */
+void encode_node(const TreeNode* node, int words, std::vector<uint64_t>& buffer) {
+    buffer.push_back((uint64_t)(int64_t)node->level);
+    buffer.insert(buffer.end(), node->decisions(), node->decisions() + words);
+}
+
+/**
+ * Rebuilds a search node from a record written by encode_node.
+ * Included items are summed in item order, the same order the search adds
+ * them in, so the totals match the sender's node exactly.
+ *
+ * @param record Start of the record (level word, then decision words)
+ * @param items Array of items in the order the search uses
+ * @param n Total number of items
+ * @param bounds Bound engine over the same items
+ * @param arena Arena the node is allocated from
+ * @param pool Arena pool of the calling thread
+ * @return The rebuilt node with weight, value and bound filled in
+ */
+TreeNode* decode_node(const uint64_t* record, const Item* items, int n,
+                      const PrefixBound& bounds, NodeArena& arena, int pool) {
+    int words = TreeNode::decision_words(n);
+    TreeNode* node = TreeNode::create_root(arena, pool, words);
+    node->level = (int)(int64_t)record[0];
+
+    const uint64_t* bits = record + 1;
+    for (int word = 0; word < words; word++) {
+        node->decisions()[word] = bits[word];
+        uint64_t rest = bits[word];
+        while (rest) {
+            int index = word * 64 + __builtin_ctzll(rest);
+            node->t_weight += items[index].weight;
+            node->t_value += items[index].value;
+            rest &= rest - 1;
+        }
+    }
+
+    node->bound = bounds.bound(node);
+    return node;
+}
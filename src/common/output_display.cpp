@@ -1,5 +1,35 @@
 #include "output_display.h"
 #include <stdio.h>
+#include <stdarg.h>
+
+namespace {
+
+bool output_enabled = true;
+
+} // namespace
+
+void set_search_output(bool enabled) {
+    output_enabled = enabled;
+}
+
+bool search_output() {
+    return output_enabled;
+}
+
+/**
+ * Prints an engine progress message unless search output is off.
+ *
+ * @param format printf format string
+ */
+void print_info(const char* format, ...) {
+    if (!output_enabled) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
 
 /**
  * Prints the sorted list of items with their ratios.
@@ -9,6 +39,9 @@
  * @param n Number of items
  */
 void print_sorted_items(Item* items, int n) {
+    if (!output_enabled) {
+        return;
+    }
     printf("\nSorted items by value/weight ratio:\n");
     for (int i = 0; i < n; i++) {
         printf("%d. Item %d: value=%.2f, weight=%.2f, ratio=%.4f\n", 
@@ -26,6 +59,9 @@ void print_sorted_items(Item* items, int n) {
  * @param nodes_pruned Number of nodes pruned due to bound checks
  */
 void print_statistics(int nodes_explored, int nodes_pruned) {
+    if (!output_enabled) {
+        return;
+    }
     printf("\nBranch and Bound Statistics:\n");
     printf("Nodes explored: %d\n", nodes_explored);
     printf("Nodes pruned: %d\n", nodes_pruned);
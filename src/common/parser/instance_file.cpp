@@ -0,0 +1,173 @@
+#include "parser/instance_file.h"
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const char INSTANCE_MAGIC[8] = { 'K', 'N', 'A', 'P', 'B', 'I', 'N', '\0' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+static_assert(sizeof(InstanceFileHeader) == INSTANCE_FILE_ALIGN,
+              "instance header must fill one aligned block");
+
+uint64_t align_up(uint64_t offset) {
+    return (offset + INSTANCE_FILE_ALIGN - 1) / INSTANCE_FILE_ALIGN * INSTANCE_FILE_ALIGN;
+}
+
+// Whether a column of count 4-byte entries at offset is aligned and inside the file
+bool column_fits(uint64_t offset, int64_t count, size_t bytes) {
+    return offset % INSTANCE_FILE_ALIGN == 0 && offset <= bytes &&
+           (uint64_t)count * 4 <= bytes - offset;
+}
+
+// Writes zero bytes until the file position reaches offset
+bool pad_to(FILE* file, uint64_t offset) {
+    static const char zeros[INSTANCE_FILE_ALIGN] = {};
+    long position = ftell(file);
+    if (position < 0 || (uint64_t)position > offset) {
+        return false;
+    }
+    size_t gap = (size_t)(offset - (uint64_t)position);
+    return fwrite(zeros, 1, gap, file) == gap;
+}
+
+} // namespace
+
+MappedInstance::MappedInstance() : base_(nullptr), bytes_(0), header_(nullptr) {}
+
+MappedInstance::~MappedInstance() {
+    close();
+}
+
+void MappedInstance::close() {
+    if (base_) {
+        munmap(base_, bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    header_ = nullptr;
+}
+
+/**
+ * Maps a binary instance file read-only and checks its header: magic,
+ * version, byte order, and that every column is aligned and lies inside
+ * the file.
+ *
+ * @param filename Path of the instance file
+ * @return false if the file cannot be mapped or is not a valid instance
+ */
+bool MappedInstance::open(const char* filename) {
+    close();
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: Cannot open file %s\n", filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(InstanceFileHeader)) {
+        printf("Error: %s is too short for a binary instance\n", filename);
+        ::close(fd);
+        return false;
+    }
+    bytes_ = (size_t)info.st_size;
+    base_ = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        printf("Error: Cannot map file %s\n", filename);
+        return false;
+    }
+    header_ = static_cast<const InstanceFileHeader*>(base_);
+
+    const char* problem = nullptr;
+    if (memcmp(header_->magic, INSTANCE_MAGIC, sizeof(INSTANCE_MAGIC)) != 0) {
+        problem = "not a binary instance";
+    } else if (header_->version != INSTANCE_FILE_VERSION) {
+        problem = "unsupported format version";
+    } else if (header_->byte_order != BYTE_ORDER_MARK) {
+        problem = "written with a different byte order";
+    } else if (header_->item_count < 0 || header_->item_count > INT_MAX) {
+        problem = "item count out of range";
+    } else if (!column_fits(header_->weight_offset, header_->item_count, bytes_) ||
+               !column_fits(header_->value_offset, header_->item_count, bytes_) ||
+               !column_fits(header_->id_offset, header_->item_count, bytes_)) {
+        problem = "column outside the file or misaligned";
+    }
+    if (problem) {
+        printf("Error: %s: %s\n", filename, problem);
+        close();
+        return false;
+    }
+    // The solvers read each column once from front to back
+    madvise(base_, bytes_, MADV_SEQUENTIAL);
+    return true;
+}
+
+/**
+ * Checks the first bytes of a file for the binary instance magic.
+ *
+ * @param filename Path of the file
+ * @return true if the file looks like a binary instance
+ */
+bool is_instance_file(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[sizeof(INSTANCE_MAGIC)];
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, INSTANCE_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return match;
+}
+
+/**
+ * Writes the header and the weight, value and id columns, each padded to
+ * the next INSTANCE_FILE_ALIGN boundary.
+ *
+ * @param filename Path of the file to create
+ * @param weight, value, id Item columns of n entries
+ * @param n Number of items
+ * @param capacity Knapsack capacity
+ * @return false (after printing the reason) if the file could not be written
+ */
+bool write_instance_file(const char* filename, const float* weight, const float* value,
+                         const int32_t* id, int n, float capacity) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Cannot create file %s\n", filename);
+        return false;
+    }
+
+    InstanceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INSTANCE_MAGIC, sizeof(INSTANCE_MAGIC));
+    header.version = INSTANCE_FILE_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.item_count = n;
+    header.capacity = capacity;
+    header.weight_offset = align_up(sizeof(InstanceFileHeader));
+    header.value_offset = align_up(header.weight_offset + (uint64_t)n * sizeof(float));
+    header.id_offset = align_up(header.value_offset + (uint64_t)n * sizeof(float));
+
+    size_t count = (size_t)n;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              pad_to(file, header.weight_offset) &&
+              fwrite(weight, sizeof(float), count, file) == count &&
+              pad_to(file, header.value_offset) &&
+              fwrite(value, sizeof(float), count, file) == count &&
+              pad_to(file, header.id_offset) &&
+              fwrite(id, sizeof(int32_t), count, file) == count;
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        printf("Error: Failed to write %s\n", filename);
+    }
+    return ok;
+}
@@ -1,55 +1,447 @@
 #include "parser.h"
+#include "parser/instance_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Files with fewer bytes of item lines than this are parsed on one thread
+const size_t PARSE_PARALLEL_MIN = 1 << 20;
+
+// Chunks per thread, so a thread with slow lines does not hold up the rest
+const int PARSE_CHUNKS_PER_THREAD = 4;
+
+// Longest number handed to the strtof fallback
+const int MAX_NUMBER_CHARS = 64;
+
+// Powers of ten exact in float (5^10 < 2^24)
+const float POW10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                        1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && is_blank(*p)) {
+        p++;
+    }
+    return p;
+}
+
+// Whether a number ends at p (blank, newline or end of input)
+inline bool at_delimiter(const char* p, const char* end) {
+    return p == end || is_blank(*p) || *p == '\n';
+}
+
+// End of the line starting at p (the newline, or end)
+inline const char* line_end(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+    return newline ? newline : end;
+}
 
 /**
- * Parses the input file to read items and knapsack capacity.
- * File format:
- * - First line: integer N (number of items)
- * - Next N lines: id value weight (space-separated floats)
- * - Last line: capacity (float)
- * 
- * @param filename Path to the input file
- * @param item_count Output: number of items read
- * @param capacity Output: knapsack capacity
- * @return Array of items, or nullptr on error
+ * Reads a decimal integer token at p.
+ *
+ * @return Position after the token, or nullptr if it is not an int
  */
-Item* read_items(const char* filename, int* item_count, float* capacity) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("Error: Cannot open file %s\n", filename);
+const char* scan_int(const char* p, const char* end, int* out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    const char* digits = p;
+    int64_t value = 0;
+    for (; p < end && (unsigned)(*p - '0') <= 9 && p - digits < 11; p++) {
+        value = value * 10 + (*p - '0');
+    }
+    value = negative ? -value : value;
+    if (p == digits || !at_delimiter(p, end) || value < INT_MIN || value > INT_MAX) {
         return nullptr;
     }
-    
-    // Read number of items
-    if (fscanf(file, "%d", item_count) != 1) {
-        printf("Error: Failed to read item count\n");
-        fclose(file);
+    *out = (int)value;
+    return p;
+}
+
+// Exponents, long mantissas, inf and nan: strtof on a terminated copy
+const char* scan_float_strtof(const char* p, const char* end, float* out) {
+    const char* stop = p;
+    while (!at_delimiter(stop, end)) {
+        stop++;
+    }
+    if (stop == p || stop - p >= MAX_NUMBER_CHARS) {
         return nullptr;
     }
-    
-    int n = *item_count;
-    Item* items = new Item[n];
-    
-    // Read each item
-    for (int i = 0; i < n; i++) {
-        if (fscanf(file, "%d %f %f", &items[i].id, &items[i].value, &items[i].weight) != 3) {
-            printf("Error: Failed to read item %d\n", i);
+    char text[MAX_NUMBER_CHARS];
+    memcpy(text, p, stop - p);
+    text[stop - p] = '\0';
+    char* parsed_end = nullptr;
+    *out = strtof(text, &parsed_end);
+    return parsed_end == text + (stop - p) ? stop : nullptr;
+}
+
+/**
+ * Reads a float token at p, independent of the locale.
+ *
+ * The digits are read into an integer mantissa m with k decimals. When
+ * m <= 2^24 and k <= 10, m and 10^k are both exact floats, so a single
+ * float division gives the correctly rounded result, the same as strtof.
+ * That covers every number written with a few decimals; anything else
+ * goes to strtof.
+ *
+ * @return Position after the token, or nullptr if it is not a float
+ */
+const char* scan_float(const char* p, const char* end, float* out) {
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    for (; p < end && (unsigned)(*p - '0') <= 9; p++, digits++) {
+        mantissa = mantissa * 10 + (*p - '0');
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && (unsigned)(*p - '0') <= 9; p++, digits++, decimals++) {
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+    }
+    // 19 digits cannot overflow the mantissa
+    if (digits > 0 && digits <= 19 && at_delimiter(p, end) &&
+        mantissa <= (1u << 24) && decimals <= 10) {
+        float value = (float)mantissa / POW10[decimals];
+        *out = negative ? -value : value;
+        return p;
+    }
+    return scan_float_strtof(start, end, out);
+}
+
+/**
+ * Reads "id value weight" at p.
+ *
+ * @return End of the line, or nullptr if the line is anything else
+ */
+const char* scan_item(const char* p, const char* end, Item* item) {
+    p = scan_int(p, end, &item->id);
+    if (p) {
+        p = scan_float(skip_blanks(p, end), end, &item->value);
+    }
+    if (p) {
+        p = scan_float(skip_blanks(p, end), end, &item->weight);
+    }
+    if (p) {
+        p = skip_blanks(p, end);
+        if (p < end && *p != '\n') {
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+long count_lines(const char* begin, const char* end) {
+    long lines = 0;
+    while ((begin = static_cast<const char*>(memchr(begin, '\n', end - begin)))) {
+        lines++;
+        begin++;
+    }
+    return lines;
+}
+
+/**
+ * Newline-aligned slice of the item lines, parsed by one thread. Its
+ * lines are counted first, which gives each chunk a line number and a
+ * slot range in the item array to parse into.
+ */
+struct Chunk {
+    const char* begin;
+    const char* end;
+    long lines;              // Newlines in the chunk
+    long first;              // Item slot of its first line
+    long count;              // Items parsed (lines less blank lines)
+    long error_line;         // 0-based line of the first bad line, or -1
+    const char* error_begin;
+    const char* error_end;
+};
+
+// Parses every line of a chunk into items[first...], skipping blank ones
+void parse_chunk(Chunk& chunk, Item* items) {
+    chunk.count = 0;
+    chunk.error_line = -1;
+    Item* out = items + chunk.first;
+    long line_index = 0;
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    while (p < end) {
+        const char* line = p;
+        p = skip_blanks(p, end);
+        if (p < end && *p != '\n') {
+            p = scan_item(p, end, &out[chunk.count]);
+            if (!p) {
+                chunk.error_line = line_index;
+                chunk.error_begin = line;
+                chunk.error_end = line_end(line, end);
+                return;
+            }
+            chunk.count++;
+        }
+        line_index++;
+        p++;
+    }
+}
+
+// Read-only mapping of a whole file
+class MappedText {
+public:
+    MappedText() : data_(nullptr), size_(0) {}
+    ~MappedText() {
+        if (data_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    bool open(const char* filename) {
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) {
+            printf("Error: Cannot open file %s\n", filename);
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            printf("Error: %s is empty\n", filename);
+            ::close(fd);
+            return false;
+        }
+        size_ = (size_t)info.st_size;
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            printf("Error: Cannot map file %s\n", filename);
+            return false;
+        }
+        data_ = static_cast<const char*>(data);
+        madvise(data, size_, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+private:
+    MappedText(const MappedText&);
+    MappedText& operator=(const MappedText&);
+
+    const char* data_;
+    size_t size_;
+};
+
+// Prints a parse error with its line number and (the start of) the line
+void print_line_error(const char* filename, long line, const char* expected,
+                      const char* begin, const char* end) {
+    while (end > begin && is_blank(end[-1])) {
+        end--;
+    }
+    int length = (int)(end - begin);
+    if (length > 60) {
+        length = 60;
+    }
+    printf("Error: %s:%ld: expected %s, got '%.*s'\n", filename, line, expected, length, begin);
+}
+
+/**
+ * Parses the text format from a memory mapping.
+ *
+ * The first non-blank line holds N and the last one the capacity. The
+ * item lines between them are cut into newline-aligned chunks. The
+ * OpenMP team counts the lines of every chunk, then parses each chunk
+ * straight into its slots of the item array. Blank lines are skipped
+ * anywhere; the few slots they leave empty are closed up at the end.
+ */
+Item* read_text_items(const char* filename, int* item_count, float* capacity) {
+    MappedText text;
+    if (!text.open(filename)) {
+        return nullptr;
+    }
+    const char* begin = text.begin();
+    const char* end = text.end();
+
+    // Header: first non-blank line
+    long header_line = 1;
+    const char* p = skip_blanks(begin, end);
+    while (p < end && *p == '\n') {
+        p = skip_blanks(p + 1, end);
+        header_line++;
+    }
+    const char* header_begin = p;
+    int n = 0;
+    p = scan_int(p, end, &n);
+    if (p) {
+        p = skip_blanks(p, end);
+    }
+    if (!p || (p < end && *p != '\n') || n < 0) {
+        print_line_error(filename, header_line, "item count", header_begin,
+                         line_end(header_begin, end));
+        return nullptr;
+    }
+    const char* body_begin = p < end ? p + 1 : end;
+
+    // Capacity: last non-blank line
+    const char* last_end = end;
+    while (last_end > body_begin && (is_blank(last_end[-1]) || last_end[-1] == '\n')) {
+        last_end--;
+    }
+    const char* last_begin = last_end;
+    while (last_begin > body_begin && last_begin[-1] != '\n') {
+        last_begin--;
+    }
+    if (last_begin == last_end) {
+        printf("Error: %s: missing capacity after line %ld\n", filename, header_line);
+        return nullptr;
+    }
+
+    // Item lines, in newline-aligned chunks (one thread in builds without
+    // OpenMP, such as the plain MPI ranks)
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    size_t body_bytes = (size_t)(last_begin - body_begin);
+    int num_chunks = body_bytes >= PARSE_PARALLEL_MIN ? num_threads * PARSE_CHUNKS_PER_THREAD : 1;
+    std::vector<Chunk> chunks(num_chunks);
+    const char* cut = body_begin;
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].begin = cut;
+        const char* target = body_begin + body_bytes * (c + 1) / num_chunks;
+        if (c + 1 == num_chunks || target >= last_begin) {
+            cut = last_begin;
+        } else if (target > cut) {
+            // Just past the newline that ends the line containing target
+            cut = line_end(target, last_begin);
+            cut = cut < last_begin ? cut + 1 : cut;
+        }
+        chunks[c].end = cut;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_threads) if(num_chunks > 1) schedule(static, 1)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].lines = count_lines(chunks[c].begin, chunks[c].end);
+    }
+    long body_lines = 0;
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].first = body_lines;
+        body_lines += chunks[c].lines;
+    }
+    long capacity_line = header_line + 1 + body_lines;
+    if (body_lines < n) {
+        printf("Error: %s: header on line %ld promises %d items, found %ld lines before "
+               "the capacity on line %ld\n", filename, header_line, n, body_lines, capacity_line);
+        return nullptr;
+    }
+
+    Item* items = new Item[body_lines > 0 ? body_lines : 1];
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_threads) if(num_chunks > 1) schedule(dynamic, 1)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        parse_chunk(chunks[c], items);
+    }
+
+    // Report the first bad line; close up the slots of blank lines
+    long found = 0;
+    for (int c = 0; c < num_chunks; c++) {
+        if (chunks[c].error_line >= 0) {
+            print_line_error(filename, header_line + 1 + chunks[c].first + chunks[c].error_line,
+                             "'id value weight'", chunks[c].error_begin, chunks[c].error_end);
             delete[] items;
-            fclose(file);
             return nullptr;
         }
+        if (found != chunks[c].first) {
+            memmove(items + found, items + chunks[c].first, chunks[c].count * sizeof(Item));
+        }
+        found += chunks[c].count;
+    }
+    if (found != n) {
+        printf("Error: %s: header on line %ld promises %d items, found %ld before "
+               "the capacity on line %ld\n", filename, header_line, n, found, capacity_line);
+        delete[] items;
+        return nullptr;
     }
-    
-    // Read capacity
-    if (fscanf(file, "%f", capacity) != 1) {
-        printf("Error: Failed to read capacity\n");
+
+    p = scan_float(skip_blanks(last_begin, last_end), last_end, capacity);
+    if (!p || skip_blanks(p, last_end) != last_end) {
+        print_line_error(filename, capacity_line, "capacity", last_begin, last_end);
         delete[] items;
-        fclose(file);
         return nullptr;
     }
-    
-    fclose(file);
+    *item_count = n;
     return items;
-}
\ No newline at end of file
+}
+
+/**
+ * Loads the items of a binary instance file (see instance_file.h): its
+ * mapped columns are copied into a new Item array, and the mapping is
+ * released on return.
+ */
+Item* read_instance_items(const char* filename, int* item_count, float* capacity) {
+    MappedInstance instance;
+    if (!instance.open(filename)) {
+        return nullptr;
+    }
+    int n = instance.size();
+    const float* weight = instance.weight();
+    const float* value = instance.value();
+    const int32_t* id = instance.id();
+    Item* items = new Item[n];
+    for (int i = 0; i < n; i++) {
+        items[i].id = id[i];
+        items[i].value = value[i];
+        items[i].weight = weight[i];
+    }
+    *item_count = n;
+    *capacity = instance.capacity();
+    return items;
+}
+
+} // namespace
+
+/**
+ * Parses the input file to read items and knapsack capacity.
+ * File format:
+ * - First line: integer N (number of items)
+ * - Next N lines: id value weight (space-separated floats)
+ * - Last line: capacity (float)
+ *
+ * The file is memory-mapped and the item lines are parsed in parallel
+ * chunks with a locale-independent number parser (see read_text_items);
+ * malformed input is reported with its line number.
+ *
+ * Binary instance files (written by convert_dataset or generate_dataset)
+ * are recognised by their magic and copied from a memory mapping instead.
+ *
+ * @param filename Path to the input file
+ * @param item_count Output: number of items read
+ * @param capacity Output: knapsack capacity
+ * @return Array of items, or nullptr on error
+ */
+Item* read_items(const char* filename, int* item_count, float* capacity) {
+    if (is_instance_file(filename)) {
+        return read_instance_items(filename, item_count, capacity);
+    }
+    return read_text_items(filename, item_count, capacity);
+}
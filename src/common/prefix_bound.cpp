@@ -0,0 +1,123 @@
+#include "prefix_bound.h"
+
+/**
+ * Precomputes prefix sums of weight and value over the sorted items.
+ * Sums are kept in double so long prefixes do not drift.
+ *
+ * @param items Array of items sorted by value/weight ratio
+ * @param n Total number of items
+ * @param capacity Maximum knapsack capacity
+ */
+PrefixBound::PrefixBound(const Item* items, int n, float capacity)
+    : n_(n),
+      capacity_(capacity),
+      prefix_weight_(n + 1, 0.0),
+      prefix_value_(n + 1, 0.0),
+      columns_(items, n) {
+    const float* weight = columns_.weight();
+    const float* value = columns_.value();
+    for (int j = 0; j < n; j++) {
+        prefix_weight_[j + 1] = prefix_weight_[j] + weight[j];
+        prefix_value_[j + 1] = prefix_value_[j] + value[j];
+    }
+}
+
+/**
+ * Finds the largest k in [first, n] with prefix_weight_[k] <= target, i.e.
+ * the critical item when filling greedily from `first`.
+ *
+ * Gallops forward from the hint (doubling the step until it overshoots)
+ * and then binary searches the last step, so the cost is logarithmic in
+ * the distance moved rather than in n.
+ */
+int PrefixBound::find_critical(int first, double target, int hint) const {
+    int lo = hint > first ? hint : first;
+    if (lo > n_ || prefix_weight_[lo] > target) {
+        lo = first;
+    }
+
+    // Gallop: prefix_weight_[lo] <= target, find hi with prefix_weight_[hi] > target
+    int step = 1;
+    int hi = lo + 1;
+    while (hi <= n_ && prefix_weight_[hi] <= target) {
+        lo = hi;
+        step *= 2;
+        hi = lo + step;
+    }
+    if (hi > n_ + 1) {
+        hi = n_ + 1;
+    }
+
+    // Binary search in (lo, hi): invariant prefix[lo] <= target < prefix[hi]
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        if (prefix_weight_[mid] <= target) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Calculates the fractional knapsack upper bound for a partial solution.
+ * Equivalent to calculate_bound: whole items are taken greedily from
+ * level + 1 while they fit, then a fraction of the critical item.
+ *
+ * @param level Last decided item index
+ * @param t_weight Weight of items selected so far
+ * @param t_value Value of items selected so far
+ * @param critical In: search hint (e.g. the parent's critical index);
+ *                 Out: index of the critical item (n if everything fits)
+ * @return Upper bound on value for this branch
+ */
+float PrefixBound::bound(int level, float t_weight, float t_value, int* critical) const {
+    // If we've exceeded capacity, this branch is infeasible
+    if (t_weight >= capacity_) {
+        return 0.0f;
+    }
+
+    Fill f = fill(level, t_weight, t_value, critical);
+    double bound = f.value;
+    if (f.critical < n_) {
+        bound += f.residual * ratio(f.critical);
+    }
+    return (float)bound;
+}
+
+/**
+ * Splits the greedy fill below a partial solution into the whole items
+ * taken and the room left for the critical item. The bound policies build
+ * their bounds from this decomposition.
+ *
+ * @param level Last decided item index
+ * @param t_weight Weight of items selected so far (below capacity)
+ * @param t_value Value of items selected so far
+ * @param critical In: search hint; Out: index of the critical item
+ * @return The greedy fill
+ */
+PrefixBound::Fill PrefixBound::fill(int level, float t_weight, float t_value, int* critical) const {
+    Fill f;
+    f.first = level + 1;
+    double residual = (double)capacity_ - t_weight;
+    double target = prefix_weight_[f.first] + residual;
+
+    f.critical = find_critical(f.first, target, *critical);
+    *critical = f.critical;
+
+    f.value = t_value + (prefix_value_[f.critical] - prefix_value_[f.first]);
+    f.residual = residual - (prefix_weight_[f.critical] - prefix_weight_[f.first]);
+    return f;
+}
+
+/**
+ * Calculates the bound for a search node, using and updating its cached
+ * critical index.
+ *
+ * @param node Current node in the search tree
+ * @return Upper bound on value for this branch
+ */
+float PrefixBound::bound(TreeNode* node) const {
+    return bound(node->level, node->t_weight, node->t_value, &node->critical);
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <random>
+#include "primal_heuristic.h"
+#include "tree_node.h"
+
+namespace {
+
+// Passes of the local search; every pass either improves or stops it
+const int MAX_PASSES = 64;
+
+/**
+ * Working solution of the heuristic as a flag per sorted item.
+ */
+struct Packing {
+    std::vector<char> in;
+    double weight;
+    double value;
+
+    explicit Packing(int n) : in(n, 0), weight(0.0), value(0.0) {}
+
+    void add(const Item* items, int j) {
+        in[j] = 1;
+        weight += items[j].weight;
+        value += items[j].value;
+    }
+
+    void remove(const Item* items, int j) {
+        in[j] = 0;
+        weight -= items[j].weight;
+        value -= items[j].value;
+    }
+};
+
+// Adds every item of the given order that still fits
+void greedy_fill(const Item* items, const std::vector<int>& order,
+                 float capacity, Packing* packing) {
+    for (size_t k = 0; k < order.size(); k++) {
+        int j = order[k];
+        if (!packing->in[j] && packing->weight + items[j].weight <= capacity) {
+            packing->add(items, j);
+        }
+    }
+}
+
+/**
+ * Exchange local search around the critical item: repeatedly applies the
+ * best swap of one packed item for one unpacked item in the core window,
+ * then refills with any item that now fits. Stops at a local optimum.
+ */
+void local_search(const Item* items, int n, float capacity,
+                  int core_begin, int core_end, Packing* packing) {
+    std::vector<int> all(n);
+    for (int j = 0; j < n; j++) {
+        all[j] = j;
+    }
+
+    for (int pass = 0; pass < MAX_PASSES; pass++) {
+        double room = capacity - packing->weight;
+        double best_gain = 0.0;
+        int best_out = -1;
+        int best_in = -1;
+        for (int out = core_begin; out < core_end; out++) {
+            if (!packing->in[out]) {
+                continue;
+            }
+            for (int in = core_begin; in < core_end; in++) {
+                if (packing->in[in]) {
+                    continue;
+                }
+                double gain = (double)items[in].value - items[out].value;
+                if (gain > best_gain &&
+                    items[in].weight - items[out].weight <= room) {
+                    best_gain = gain;
+                    best_out = out;
+                    best_in = in;
+                }
+            }
+        }
+        if (best_out < 0) {
+            break;
+        }
+        packing->remove(items, best_out);
+        packing->add(items, best_in);
+        greedy_fill(items, all, capacity, packing);
+    }
+}
+
+} // namespace
+
+/**
+ * Primal heuristic for 0/1 Knapsack.
+ *
+ * Runs before the search so that the first nodes can already be pruned
+ * against a good incumbent instead of 0:
+ *  1. Greedy: items in ratio order (or a perturbed order for seed != 0),
+ *     each taken if it still fits.
+ *  2. Extended greedy: the single most valuable item, if it beats (1).
+ *  3. Local search: best 2-swap (one item out, one in) among the items
+ *     around the critical item, followed by 1-swaps (adding any item that
+ *     fits), until no swap improves.
+ *
+ * The value and weight are summed in float in item order, as a search path
+ * would, so the incumbent compares exactly against search nodes.
+ *
+ * @param items Array of items sorted by value/weight ratio
+ * @param n Number of items
+ * @param capacity Knapsack capacity
+ * @param seed 0 for the plain greedy start, anything else to perturb it
+ * @param out Output: the best solution found
+ */
+void primal_heuristic(const Item* items, int n, float capacity,
+                      unsigned int seed, HeuristicSolution* out) {
+    out->decisions.assign(TreeNode::decision_words(n), 0);
+    out->value = 0.0f;
+    out->weight = 0.0f;
+    if (n == 0) {
+        return;
+    }
+
+    // Greedy order, perturbed by short random swaps for seeded runs
+    std::vector<int> order(n);
+    for (int j = 0; j < n; j++) {
+        order[j] = j;
+    }
+    if (seed != 0) {
+        std::mt19937 rng(seed);
+        for (int j = 0; j + 1 < n; j++) {
+            if (rng() % 4 == 0) {
+                int k = j + 1 + (int)(rng() % std::min(4, n - j - 1));
+                std::swap(order[j], order[k]);
+            }
+        }
+    }
+
+    Packing greedy(n);
+    greedy_fill(items, order, capacity, &greedy);
+
+    // Critical item of the plain greedy: the exchange window is centred on it
+    int critical = 0;
+    float prefix = 0.0f;
+    while (critical < n && prefix + items[critical].weight <= capacity) {
+        prefix += items[critical].weight;
+        critical++;
+    }
+
+    // Most valuable item on its own
+    int best_single = -1;
+    for (int j = 0; j < n; j++) {
+        if (items[j].weight <= capacity &&
+            (best_single < 0 || items[j].value > items[best_single].value)) {
+            best_single = j;
+        }
+    }
+    if (best_single >= 0 && items[best_single].value > greedy.value) {
+        greedy = Packing(n);
+        greedy.add(items, best_single);
+    }
+
+    Packing improved = greedy;
+    local_search(items, n, capacity,
+                 std::max(0, critical - HEURISTIC_CORE),
+                 std::min(n, critical + HEURISTIC_CORE + 1),
+                 &improved);
+
+    // Sum in float, in item order, exactly as the search would
+    const Packing* candidates[2] = {&improved, &greedy};
+    for (int c = 0; c < 2; c++) {
+        float weight = 0.0f;
+        float value = 0.0f;
+        for (int j = 0; j < n; j++) {
+            if (candidates[c]->in[j]) {
+                weight += items[j].weight;
+                value += items[j].value;
+            }
+        }
+        if (weight <= capacity) {
+            out->value = value;
+            out->weight = weight;
+            for (int j = 0; j < n; j++) {
+                if (candidates[c]->in[j]) {
+                    out->decisions[j / 64] |= 1ULL << (j % 64);
+                }
+            }
+            return;
+        }
+    }
+}
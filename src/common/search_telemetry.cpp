@@ -0,0 +1,150 @@
+#include "search_telemetry.h"
+#include "output_display.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <new>
+
+namespace {
+
+std::string trace_file;
+
+const char* const EVENT_NAMES[] = { "start", "improvement", "sample", "finish" };
+
+} // namespace
+
+void set_search_trace_file(const std::string& path) {
+    trace_file = path;
+}
+
+const std::string& search_trace_file() {
+    return trace_file;
+}
+
+/**
+ * Allocates one zeroed, cache-line aligned counter block per thread and
+ * starts the clock of the trace.
+ *
+ * @param num_threads Number of search threads
+ */
+SearchTelemetry::SearchTelemetry(int num_threads)
+    : threads_(nullptr),
+      num_threads_(num_threads),
+      start_(std::chrono::steady_clock::now()),
+      tracing_(!trace_file.empty()),
+      next_sample_(TRACE_SAMPLE_SECONDS) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 64, sizeof(ThreadTelemetry) * num_threads_) != 0) {
+        throw std::bad_alloc();
+    }
+    threads_ = static_cast<ThreadTelemetry*>(memory);
+    memset(threads_, 0, sizeof(ThreadTelemetry) * num_threads_);
+}
+
+SearchTelemetry::~SearchTelemetry() {
+    free(threads_);
+}
+
+ThreadTelemetry SearchTelemetry::total() const {
+    ThreadTelemetry sum;
+    memset(&sum, 0, sizeof(sum));
+    for (int t = 0; t < num_threads_; t++) {
+        const ThreadTelemetry& stats = threads_[t];
+        sum.expanded += stats.expanded;
+        sum.pruned_bound += stats.pruned_bound;
+        sum.pruned_children += stats.pruned_children;
+        sum.dominated += stats.dominated;
+        sum.leaves += stats.leaves;
+        sum.steals += stats.steals;
+        sum.failed_steals += stats.failed_steals;
+        sum.queue_high_water = std::max(sum.queue_high_water, stats.queue_high_water);
+        sum.idle_seconds += stats.idle_seconds;
+    }
+    return sum;
+}
+
+double SearchTelemetry::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+// Claims the current sample period for the calling thread, if it is due
+// and no other thread has claimed it yet
+bool SearchTelemetry::claim_sample_slow() {
+    double now = elapsed();
+    double due = next_sample_.load(std::memory_order_relaxed);
+    if (now < due) {
+        return false;
+    }
+    return next_sample_.compare_exchange_strong(due, now + TRACE_SAMPLE_SECONDS,
+                                                std::memory_order_relaxed);
+}
+
+void SearchTelemetry::record(TraceEvent event, int thread, float incumbent, float open_bound) {
+    if (!tracing_) {
+        return;
+    }
+    TracePoint point;
+    point.seconds = elapsed();
+    point.event = event;
+    point.thread = thread;
+    point.incumbent = incumbent;
+    point.open_bound = open_bound;
+    trace_.push_back(point);
+}
+
+void SearchTelemetry::report() const {
+    print_info("\nPer-thread search telemetry:\n");
+    print_info("%6s %12s %12s %12s %10s %8s %10s %10s %10s %9s\n",
+               "thread", "expanded", "pruned", "pruned_kids", "dominated", "leaves",
+               "steals", "failed", "queue_peak", "idle_s");
+    for (int t = 0; t <= num_threads_; t++) {
+        bool is_total = t == num_threads_;
+        ThreadTelemetry stats = is_total ? total() : threads_[t];
+        char label[16] = "total";
+        if (!is_total) {
+            snprintf(label, sizeof(label), "%d", t);
+        }
+        print_info("%6s %12lld %12lld %12lld %10lld %8lld %10lld %10lld %10lld %9.3f\n",
+                   label, stats.expanded, stats.pruned_bound, stats.pruned_children,
+                   stats.dominated, stats.leaves, stats.steals, stats.failed_steals,
+                   stats.queue_high_water, stats.idle_seconds);
+    }
+}
+
+/**
+ * Writes the trace as CSV: seconds since the search started, event, thread
+ * (empty for none), incumbent value and best open bound (empty on
+ * improvement rows and when not known).
+ *
+ * @return false if the file could not be written
+ */
+bool SearchTelemetry::write_trace() const {
+    if (!tracing_) {
+        return true;
+    }
+    FILE* file = fopen(trace_file.c_str(), "w");
+    if (!file) {
+        printf("Warning: Could not open trace file %s\n", trace_file.c_str());
+        return false;
+    }
+    fprintf(file, "seconds,event,thread,incumbent,open_bound\n");
+    for (size_t i = 0; i < trace_.size(); i++) {
+        const TracePoint& point = trace_[i];
+        fprintf(file, "%.6f,%s,", point.seconds, EVENT_NAMES[point.event]);
+        if (point.thread >= 0) {
+            fprintf(file, "%d", point.thread);
+        }
+        fprintf(file, ",%.2f,", point.incumbent);
+        if (point.open_bound >= 0.0f) {
+            fprintf(file, "%.2f", point.open_bound);
+        }
+        fprintf(file, "\n");
+    }
+    bool ok = !ferror(file);
+    if (fclose(file) != 0 || !ok) {
+        printf("Warning: Could not write trace file %s\n", trace_file.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,132 @@
+#include <math.h>
+#include <algorithm>
+#include "variable_fixing.h"
+#include "knapsack_utils.h"
+#include "output_display.h"
+#include "primal_heuristic.h"
+
+namespace {
+
+bool fixing_enabled = true;
+
+} // namespace
+
+void set_variable_fixing(bool enabled) {
+    fixing_enabled = enabled;
+}
+
+bool variable_fixing() {
+    return fixing_enabled;
+}
+
+/**
+ * Reduced-cost variable fixing (Dembo-Hammer) for 0/1 Knapsack.
+ *
+ * With items in ratio order, the LP relaxation takes every item before the
+ * critical item s whole and a fraction of s; its dual price is the critical
+ * ratio r = v_s / w_s. Forcing item j away from its LP value costs at least
+ * its reduced cost |v_j - r * w_j|, so no solution with j flipped is worth
+ * more than U - |v_j - r * w_j|, where U is the LP bound. If that is below
+ * a known feasible value L (from the primal heuristic), j keeps its LP value
+ * in every optimal solution: items before s are fixed in, items after s
+ * fixed out.
+ *
+ * On uncorrelated instances ratios spread widely around r and most items
+ * are fixed; on strongly correlated ones reduced costs are tiny and few are.
+ *
+ * @param items Array of items (sorted by ratio in place)
+ * @param n Number of items
+ * @param capacity Knapsack capacity
+ * @param out Output: fixed items and the reduced problem
+ */
+void fix_variables(Item* items, int n, float capacity, ReducedProblem* out) {
+    sort_items(items, n);
+
+    out->free_items.clear();
+    out->fixed_in.clear();
+    out->fixed_out = 0;
+    out->fixed_value = 0.0f;
+    out->capacity = capacity;
+
+    // Critical item: first one that no longer fits whole
+    double prefix_weight = 0.0;
+    double prefix_value = 0.0;
+    int critical = 0;
+    while (critical < n && prefix_weight + items[critical].weight <= capacity) {
+        prefix_weight += items[critical].weight;
+        prefix_value += items[critical].value;
+        critical++;
+    }
+
+    // Everything fits: the whole instance is the answer
+    if (critical == n) {
+        for (int j = 0; j < n; j++) {
+            out->fixed_in.push_back(items[j]);
+            out->fixed_value += items[j].value;
+        }
+        out->capacity = capacity - (float)prefix_weight;
+        out->lower_bound = out->upper_bound = out->fixed_value;
+        print_info("Variable fixing: all %d items fit\n", n);
+        return;
+    }
+
+    double ratio = (double)items[critical].value / items[critical].weight;
+    double upper = prefix_value + (capacity - prefix_weight) * ratio;
+
+    // Incumbent from the primal heuristic (at least the greedy fill)
+    HeuristicSolution seed;
+    primal_heuristic(items, n, capacity, 0, &seed);
+    double incumbent = seed.value;
+    out->lower_bound = seed.value;
+    out->upper_bound = (float)upper;
+
+    // Fix only when flipping j is provably worse than the incumbent by
+    // more than float noise, so every optimal solution survives
+    double threshold = incumbent - incumbent * BOUND_TOLERANCE;
+    float fixed_weight = 0.0f;
+    for (int j = 0; j < n; j++) {
+        double reduced_cost = fabs(items[j].value - ratio * items[j].weight);
+        bool fixed = j != critical && upper - reduced_cost < threshold;
+        if (!fixed) {
+            out->free_items.push_back(items[j]);
+        } else if (j < critical) {
+            out->fixed_in.push_back(items[j]);
+            out->fixed_value += items[j].value;
+            fixed_weight += items[j].weight;
+        } else {
+            out->fixed_out++;
+        }
+    }
+    out->capacity = capacity - fixed_weight;
+    print_info("Variable fixing: %d in, %d out, %d free (incumbent %.2f, LP bound %.2f)\n",
+               (int)out->fixed_in.size(), out->fixed_out, (int)out->free_items.size(),
+               out->lower_bound, out->upper_bound);
+}
+
+/**
+ * Maps a solution of the reduced problem back to the original one by
+ * adding the fixed-in items. Items carry their original IDs throughout.
+ *
+ * @param reduced Preprocessing result
+ * @param reduced_value Optimal value of the reduced problem
+ * @param reduced_items Items selected in the reduced problem
+ * @param reduced_count Number of items selected in the reduced problem
+ * @param n Number of items in the original problem
+ * @param max_value Output: optimal value of the original problem
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ */
+void expand_solution(const ReducedProblem& reduced,
+                     float reduced_value, const Item* reduced_items,
+                     int reduced_count, int n,
+                     float* max_value, Item** best_items, int* best_count) {
+    *best_items = new Item[n];
+    *best_count = 0;
+    for (size_t j = 0; j < reduced.fixed_in.size(); j++) {
+        (*best_items)[(*best_count)++] = reduced.fixed_in[j];
+    }
+    for (int j = 0; j < reduced_count; j++) {
+        (*best_items)[(*best_count)++] = reduced_items[j];
+    }
+    *max_value = reduced.fixed_value + reduced_value;
+}
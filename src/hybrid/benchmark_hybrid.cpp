@@ -0,0 +1,128 @@
+/**
+ * Benchmark driver for the hybrid MPI + OpenMP branch and bound
+ * Takes the same options as the sequential / OpenMP driver (engine options
+ * do not apply); --threads sets the OpenMP threads per process, all cores
+ * by default, and the process count comes from mpirun.
+ *
+ * Usage: mpirun -np <processes> ./benchmark_hybrid [options] <dataset>...
+ */
+
+#include <mpi.h>
+#include <omp.h>
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include "parser/parser.h"
+#include "branch_and_bound_hybrid.h"
+#include "output_display.h"
+#include "benchmark_harness.h"
+
+int main(int argc, char* argv[]) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+
+    int world_rank = 0;
+    int world_size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+    BenchmarkConfig config;
+    if (!parse_benchmark_args(argc, argv, &config, world_rank == 0)) {
+        MPI_Finalize();
+        return 1;
+    }
+    if (config.thread_counts.empty()) {
+        config.thread_counts.push_back(omp_get_max_threads());
+    }
+    set_search_output(config.verbose);
+    set_variable_fixing(config.fix_variables);
+
+    if (world_rank == 0) {
+        printf("Hybrid MPI + OpenMP Branch and Bound Benchmark\n");
+        printf("============================================\n");
+        printf("Processes: %d\n", world_size);
+        printf("Warm-up runs: %d, timed runs: %d\n\n", config.warmup, config.iterations);
+    }
+
+    std::vector<BenchmarkResult> results;
+    int status = 0;
+    for (size_t d = 0; d < config.datasets.size(); d++) {
+        const char* path = config.datasets[d].c_str();
+        int item_count = 0;
+        float capacity = 0.0f;
+        Item* initial_items = read_items_shared(path, &item_count, &capacity, MPI_COMM_WORLD);
+        if (initial_items == nullptr) {
+            if (world_rank == 0) {
+                printf("Error: Failed to load items from file %s\n", path);
+            }
+            status = 1;
+            continue;
+        }
+
+        std::vector<Item> template_items(initial_items, initial_items + item_count);
+        delete[] initial_items;
+
+        for (size_t t = 0; t < config.thread_counts.size(); t++) {
+            int num_threads = config.thread_counts[t];
+
+            BenchmarkResult result;
+            result.dataset = dataset_name(path);
+            result.implementation = "hybrid";
+            result.processes = world_size;
+            result.threads = num_threads;
+            result.warmup = config.warmup;
+
+            for (int iter = 0; iter < config.warmup + config.iterations; ++iter) {
+                Item* items_copy = new Item[item_count];
+                std::copy(template_items.begin(), template_items.end(), items_copy);
+
+                MPI_Barrier(MPI_COMM_WORLD);
+                double start = MPI_Wtime();
+
+                float max_value = 0.0f;
+                Item* best_items = nullptr;
+                int best_count = 0;
+                MpiStats stats{0, 0};
+                branch_and_bound_hybrid(items_copy,
+                                        item_count,
+                                        capacity,
+                                        num_threads,
+                                        &max_value,
+                                        &best_items,
+                                        &best_count,
+                                        &stats,
+                                        MPI_COMM_WORLD);
+
+                double end = MPI_Wtime();
+                double elapsed = end - start;
+
+                delete[] items_copy;
+                delete[] best_items;
+
+                if (world_rank == 0 && iter >= config.warmup) {
+                    result.seconds.push_back(elapsed);
+                    result.optimal_value = max_value;
+                    result.nodes_explored += stats.nodes_explored;
+                    result.nodes_pruned += stats.nodes_pruned;
+                }
+            }
+
+            if (world_rank == 0) {
+                result.timing = summarize_timings(result.seconds);
+                print_benchmark_result(result);
+                if (!config.results_dir.empty()) {
+                    append_benchmark_csv(config.results_dir, result);
+                }
+                results.push_back(result);
+            }
+        }
+    }
+
+    if (world_rank == 0 && !config.json_file.empty() &&
+        write_benchmark_json(config.json_file, results)) {
+        printf("\nResults written to %s\n", config.json_file.c_str());
+    }
+
+    MPI_Finalize();
+    return status;
+}
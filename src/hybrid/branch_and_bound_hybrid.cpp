@@ -0,0 +1,534 @@
+/**
+ * Hybrid MPI + OpenMP Branch and Bound implementation for 0/1 Knapsack
+ *
+ * Meant to run with one MPI rank per machine. All ranks expand the same top
+ * of the tree into a list of subtree roots; ranks claim roots one at a time
+ * through an RMA counter on rank 0, so faster ranks simply claim more. Inside
+ * a rank a team of OpenMP threads searches the claimed subtrees with
+ * per-thread work-stealing deques. The incumbent is shared within the rank
+ * through an atomic and across ranks through an RMA window.
+ */
+
+#include <mpi.h>
+#include <omp.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <queue>
+#include <vector>
+#include "branch_and_bound_hybrid.h"
+#include "knapsack_utils.h"
+#include "prefix_bound.h"
+#include "output_display.h"
+#include "primal_heuristic.h"
+#include "search_telemetry.h"
+#include "incumbent_window.h"
+#include "work_stealing_deque.h"
+
+namespace {
+
+// Subtree roots generated per thread in the whole job
+const int ROOTS_PER_THREAD = 8;
+
+// Expansions between reads of the global incumbent
+const int POLL_INTERVAL = 64;
+
+/**
+ * Job-wide counter of claimed subtree roots, kept in an RMA window on
+ * rank 0 and advanced with MPI_Fetch_and_op. Construction and destruction
+ * are collective over the communicator.
+ */
+class RootCounter {
+public:
+    explicit RootCounter(MPI_Comm comm) : next_(nullptr) {
+        int rank = 0;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Aint bytes = rank == 0 ? (MPI_Aint)sizeof(int) : 0;
+        MPI_Win_allocate(bytes, sizeof(int), MPI_INFO_NULL, comm, &next_, &window_);
+        if (rank == 0) {
+            *next_ = 0;
+        }
+        MPI_Barrier(comm);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+    }
+
+    ~RootCounter() {
+        MPI_Win_unlock_all(window_);
+        MPI_Win_free(&window_);
+    }
+
+    // Returns the next unclaimed root index (may be past the end)
+    int claim() {
+        int one = 1;
+        int index = 0;
+        MPI_Fetch_and_op(&one, &index, MPI_INT, 0, 0, MPI_SUM, window_);
+        MPI_Win_flush(0, window_);
+        return index;
+    }
+
+private:
+    RootCounter(const RootCounter&);
+    RootCounter& operator=(const RootCounter&);
+
+    int* next_;
+    MPI_Win window_;
+};
+
+/**
+ * Search state of one rank, shared by its threads.
+ * All MPI calls made from inside the thread team go through the named
+ * critical section `mpi`, which is what MPI_THREAD_SERIALIZED requires.
+ */
+struct HybridSearch {
+    Item* items;
+    int n;
+    float capacity;
+    int words;
+    const PrefixBound& bounds;
+    NodeArena arena;
+    IncumbentWindow& incumbent;
+
+    // Best value known on this rank (own or read from the window)
+    std::atomic<float> best_value;
+    // Best solution found on this rank itself, guarded by best_lock
+    float own_best_value;
+    std::vector<uint64_t> best_decisions;
+    omp_lock_t best_lock;
+
+    // Node counts, one cache-line block per thread (indexed by arena pool),
+    // summed after the search
+    SearchTelemetry telemetry;
+
+    HybridSearch(Item* items, int n, float capacity, const PrefixBound& bounds,
+                 int num_threads, IncumbentWindow& incumbent)
+        : items(items),
+          n(n),
+          capacity(capacity),
+          words(TreeNode::decision_words(n)),
+          bounds(bounds),
+          arena(num_threads, TreeNode::bytes_for(n)),
+          incumbent(incumbent),
+          best_value(0.0f),
+          own_best_value(0.0f),
+          best_decisions(words, 0),
+          telemetry(num_threads) {
+        omp_init_lock(&best_lock);
+    }
+
+    ~HybridSearch() {
+        omp_destroy_lock(&best_lock);
+    }
+
+    // Starts from a heuristic solution as this rank's own best
+    void seed_incumbent(const HeuristicSolution& seed) {
+        best_value.store(seed.value, std::memory_order_relaxed);
+        own_best_value = seed.value;
+        best_decisions = seed.decisions;
+    }
+
+    // Raises the rank's view of the incumbent to at least value
+    void absorb_incumbent(float value) {
+        float current = best_value.load(std::memory_order_relaxed);
+        while (value > current &&
+               !best_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Records node as this rank's best solution if it beats the incumbent
+    void offer_incumbent(TreeNode* node) {
+        bool improved = false;
+        omp_set_lock(&best_lock);
+        if (node->t_value > best_value.load(std::memory_order_relaxed)) {
+            best_value.store(node->t_value, std::memory_order_relaxed);
+            own_best_value = node->t_value;
+            std::copy(node->decisions(), node->decisions() + words,
+                      best_decisions.begin());
+            improved = true;
+        }
+        omp_unset_lock(&best_lock);
+
+        if (improved) {
+            #pragma omp critical(mpi)
+            incumbent.publish(node->t_value);
+        }
+    }
+
+    /**
+     * Expands one node: prunes it or generates its children, and recycles
+     * it into the caller's pool.
+     *
+     * @param children Output: up to two promising children, exclude branch
+     *                 first, so pushing them in order explores include first
+     * @return Number of children written
+     */
+    int expand(TreeNode* current, int pool, TreeNode** children) {
+        ThreadTelemetry& stats = telemetry.thread(pool);
+        stats.expanded++;
+
+        if (!can_improve(current->bound, best_value.load(std::memory_order_relaxed))) {
+            stats.pruned_bound++;
+            arena.recycle(current, pool);
+            return 0;
+        }
+
+        if (current->level == n - 1) {
+            arena.recycle(current, pool);
+            return 0;
+        }
+
+        int next_level = current->level + 1;
+        TreeNode* left_child = nullptr;
+
+        // Left child: include next item if feasible
+        if (current->t_weight + items[next_level].weight <= capacity) {
+            left_child = current->add(
+                arena, pool, words, true,
+                current->t_weight + items[next_level].weight,
+                current->t_value + items[next_level].value
+            );
+            left_child->bound = bounds.bound(left_child);
+
+            if (left_child->t_value > best_value.load(std::memory_order_relaxed)) {
+                offer_incumbent(left_child);
+            }
+        }
+
+        // Right child: exclude next item (always feasible)
+        TreeNode* right_child = current->add(
+            arena, pool, words, false,
+            current->t_weight, current->t_value
+        );
+        right_child->bound = bounds.bound(right_child);
+
+        float current_best = best_value.load(std::memory_order_relaxed);
+        int count = 0;
+        if (can_improve(right_child->bound, current_best)) {
+            children[count++] = right_child;
+        } else {
+            arena.recycle(right_child, pool);
+        }
+        if (left_child) {
+            if (can_improve(left_child->bound, current_best)) {
+                children[count++] = left_child;
+            } else {
+                arena.recycle(left_child, pool);
+            }
+        }
+
+        arena.recycle(current, pool);
+        return count;
+    }
+
+    /**
+     * Expands the top of the tree best-first until there are `target` open
+     * nodes. Every rank runs this identically, so all ranks hold the same
+     * root list in the same order without communicating. Only the rank
+     * with keep_counts set counts the split's nodes, so the job totals
+     * include them once.
+     */
+    std::vector<TreeNode*> split(int target, bool keep_counts) {
+        std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> pq;
+        TreeNode* root = TreeNode::create_root(arena, 0, words);
+        root->bound = bounds.bound(root);
+        pq.push(root);
+
+        TreeNode* children[2];
+        while (!pq.empty() && (int)pq.size() < target) {
+            TreeNode* current = pq.top();
+            pq.pop();
+            int count = expand(current, 0, children);
+            for (int i = 0; i < count; i++) {
+                pq.push(children[i]);
+            }
+        }
+
+        std::vector<TreeNode*> roots;
+        while (!pq.empty()) {
+            roots.push_back(pq.top());
+            pq.pop();
+        }
+
+        // Nothing else has been counted yet
+        if (!keep_counts) {
+            memset(&telemetry.thread(0), 0, sizeof(ThreadTelemetry));
+        }
+        return roots;
+    }
+};
+
+/**
+ * Hybrid MPI + OpenMP Branch and Bound for 0/1 Knapsack.
+ *
+ * Algorithm steps:
+ * 1. Sort items by value/weight ratio and build the prefix-sum bounds
+ * 2. Expand the top of the tree into ROOTS_PER_THREAD roots per thread of
+ *    the job (identically on every rank)
+ * 3. In each rank, threads pop from their own deque; an empty thread claims
+ *    the next root from the job-wide RMA counter, and once all roots are
+ *    claimed it steals from the other threads of its rank
+ * 4. Incumbents are published to and read from the RMA window every
+ *    POLL_INTERVAL expansions
+ * 5. The rank with the best solution broadcasts it
+ *
+ * @param items Array of available items
+ * @param item_count Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param num_threads OpenMP threads per rank
+ * @param global_best_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param stats Output: node statistics summed over all ranks
+ * @param comm Communicator of the participating ranks
+ */
+void search_hybrid(Item* items,
+                   int item_count,
+                   float capacity,
+                   int num_threads,
+                   float* global_best_value,
+                   Item** best_items,
+                   int* best_count,
+                   MpiStats* stats,
+                   MPI_Comm comm) {
+    int world_rank = 0;
+    int world_size = 1;
+    MPI_Comm_rank(comm, &world_rank);
+    MPI_Comm_size(comm, &world_size);
+
+    if (item_count == 0) {
+        if (global_best_value) *global_best_value = 0.0f;
+        if (best_items) *best_items = nullptr;
+        if (best_count) *best_count = 0;
+        if (stats) {
+            stats->nodes_explored = 0;
+            stats->nodes_pruned = 0;
+        }
+        return;
+    }
+
+    // Threads call MPI one at a time, which needs MPI_THREAD_SERIALIZED
+    int thread_level = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&thread_level);
+    if (thread_level < MPI_THREAD_SERIALIZED && num_threads > 1) {
+        if (world_rank == 0) {
+            printf("Warning: MPI lacks MPI_THREAD_SERIALIZED, using 1 thread per rank\n");
+        }
+        num_threads = 1;
+    }
+
+    // Sort items
+    sort_items(items, item_count);
+    if (world_rank == 0) {
+        print_sorted_items(items, item_count);
+    }
+
+    // Prefix sums over the sorted items make each bound O(log n)
+    PrefixBound bounds(items, item_count, capacity);
+
+    IncumbentWindow incumbent(comm);
+    RootCounter root_counter(comm);
+    HybridSearch search(items, item_count, capacity, bounds, num_threads, incumbent);
+
+    // Every rank runs the primal heuristic from its own start; the best
+    // value is every rank's initial incumbent
+    HeuristicSolution seed;
+    primal_heuristic(items, item_count, capacity, (unsigned int)world_rank, &seed);
+    search.seed_incumbent(seed);
+    float seeded = 0.0f;
+    MPI_Allreduce(&seed.value, &seeded, 1, MPI_FLOAT, MPI_MAX, comm);
+    search.absorb_incumbent(seeded);
+    if (world_rank == 0) {
+        print_info("Primal heuristic (best of %d starts): %.2f\n", world_size, seeded);
+    }
+
+    std::vector<TreeNode*> roots = search.split(world_size * num_threads * ROOTS_PER_THREAD,
+                                                 world_rank == 0);
+    const int root_count = (int)roots.size();
+
+    WorkDeque* deques = new WorkDeque[num_threads];
+    std::atomic<int> idle_threads(0);
+    std::atomic<bool> roots_exhausted(root_count == 0);
+
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    {
+        int thread_id = omp_get_thread_num();
+        int team_size = omp_get_num_threads();
+        WorkDeque& own = deques[thread_id];
+        TreeNode* children[2];
+        int since_poll = 0;
+
+        // xorshift state for picking steal victims
+        unsigned int rng = 2463534242u ^ (unsigned int)(thread_id * 2654435761u);
+        bool idle = false;
+
+        while (true) {
+            TreeNode* current = own.pop();
+
+            // Out of local work: claim the next root of the job
+            if (!current && !roots_exhausted.load()) {
+                int index = 0;
+                #pragma omp critical(mpi)
+                index = root_counter.claim();
+                if (index < root_count) {
+                    current = roots[index];
+                } else {
+                    roots_exhausted.store(true);
+                }
+            }
+
+            if (!current) {
+                if (!idle) {
+                    idle = true;
+                    idle_threads.fetch_add(1);
+                }
+
+                // Try every other thread once, starting at a random victim
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                int start = team_size > 1 ? (int)(rng % (unsigned int)team_size) : 0;
+                for (int k = 0; k < team_size && !current; k++) {
+                    int victim = (start + k) % team_size;
+                    if (victim != thread_id) {
+                        current = deques[victim].steal(idle_threads);
+                    }
+                }
+
+                if (!current) {
+                    // Roots gone and every thread idle: this rank is done
+                    if (idle_threads.load() == team_size) {
+                        break;
+                    }
+                    continue;
+                }
+                idle = false;
+            }
+
+            int count = search.expand(current, thread_id, children);
+            for (int i = 0; i < count; i++) {
+                own.push(children[i]);
+            }
+
+            if (++since_poll >= POLL_INTERVAL) {
+                since_poll = 0;
+                float global = 0.0f;
+                #pragma omp critical(mpi)
+                global = incumbent.fetch();
+                search.absorb_incumbent(global);
+            }
+        }
+    }
+
+    delete[] deques;
+
+    // Find global best across all ranks
+    float local_best = search.best_value.load();
+    float global_best = 0.0f;
+    MPI_Allreduce(&local_best, &global_best, 1, MPI_FLOAT, MPI_MAX, comm);
+
+    // Gather statistics
+    ThreadTelemetry local = search.telemetry.total();
+    long long local_explored = local.expanded;
+    long long local_pruned = local.pruned_bound;
+    long long total_nodes_explored = 0;
+    long long total_nodes_pruned = 0;
+    MPI_Allreduce(&local_explored, &total_nodes_explored, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    MPI_Allreduce(&local_pruned, &total_nodes_pruned, 1, MPI_LONG_LONG, MPI_SUM, comm);
+
+    int solution_count = broadcast_best_solution(search.own_best_value,
+                                                 search.best_decisions.data(),
+                                                 items, item_count, best_items, comm);
+
+    // Set output parameters
+    if (global_best_value) {
+        *global_best_value = global_best;
+    }
+    if (best_count) {
+        *best_count = solution_count;
+    }
+    if (stats) {
+        stats->nodes_explored = (int)total_nodes_explored;
+        stats->nodes_pruned = (int)total_nodes_pruned;
+    }
+}
+
+} // namespace
+
+/**
+ * Hybrid search (search_hybrid) over the items left free by reduced-cost
+ * variable fixing, or all items if set_variable_fixing(false) was called.
+ * Fixing runs on rank 0 and the reduced problem is broadcast; every rank
+ * returns the solution of the full problem. Parameters as search_hybrid.
+ */
+void branch_and_bound_hybrid(Item* items,
+                             int item_count,
+                             float capacity,
+                             int num_threads,
+                             float* global_best_value,
+                             Item** best_items,
+                             int* best_count,
+                             MpiStats* stats,
+                             MPI_Comm comm) {
+    if (!variable_fixing()) {
+        search_hybrid(items, item_count, capacity, num_threads, global_best_value,
+                      best_items, best_count, stats, comm);
+        return;
+    }
+
+    // Nothing is searched if every item is fixed
+    if (stats) {
+        stats->nodes_explored = 0;
+        stats->nodes_pruned = 0;
+    }
+
+    ReducedProblem reduced;
+    fix_variables_shared(items, item_count, capacity, &reduced, comm);
+    solve_reduced(&reduced, item_count, global_best_value, best_items, best_count,
+                  [&](Item* free_items, int free_count, float free_capacity,
+                      float* value, Item** chosen, int* chosen_count) {
+                      search_hybrid(free_items, free_count, free_capacity, num_threads,
+                                    value, chosen, chosen_count, stats, comm);
+                  });
+}
+
+/**
+ * Reads the instance on rank 0 and broadcasts it to every rank.
+ *
+ * @param filename Path of the instance file
+ * @param item_count Output: number of items
+ * @param capacity Output: knapsack capacity
+ * @param comm Communicator to broadcast over
+ * @return new[]-allocated items, or nullptr on every rank if reading failed
+ */
+Item* read_items_shared(const char* filename, int* item_count, float* capacity,
+                        MPI_Comm comm) {
+    int world_rank = 0;
+    MPI_Comm_rank(comm, &world_rank);
+
+    Item* items = nullptr;
+    int count = -1;
+    float cap = 0.0f;
+    if (world_rank == 0) {
+        items = read_items(filename, &count, &cap);
+        if (items == nullptr) {
+            count = -1;
+        }
+    }
+
+    MPI_Bcast(&count, 1, MPI_INT, 0, comm);
+    if (count < 0) {
+        return nullptr;
+    }
+    MPI_Bcast(&cap, 1, MPI_FLOAT, 0, comm);
+
+    if (world_rank != 0) {
+        items = new Item[count];
+    }
+    // Items are plain structs and every rank runs the same binary
+    MPI_Bcast(items, count * (int)sizeof(Item), MPI_BYTE, 0, comm);
+
+    *item_count = count;
+    *capacity = cap;
+    return items;
+}
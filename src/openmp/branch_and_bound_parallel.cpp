@@ -1,88 +1,372 @@
-#include <queue>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include <algorithm>
 #include <vector>
-#include <functional>
+#include <math.h>
 #include <omp.h>
 #include <atomic>
 #include "branch_and_bound_parallel.h"
 #include "knapsack_utils.h"
+#include "prefix_bound.h"
+#include "dominance_table.h"
 #include "output_display.h"
+#include "primal_heuristic.h"
+#include "search_telemetry.h"
+#include "variable_fixing.h"
+#include "work_stealing_deque.h"
+#include "multi_queue.h"
+
+namespace {
 
 /**
- * Reconstructs the optimal solution by traversing the search tree.
- * Performs depth-first search from root to find the path leading to best_node,
- * collecting all items that were included along the path.
- * 
- * @param root Root of the search tree
- * @param best_node Node containing the optimal solution
- * @param best_items Output array to store selected items
- * @param best_count Output count of selected items
+ * State shared by the threads of one parallel search: the sorted instance,
+ * the bound engine, the node arena (one pool per thread), the incumbent and
+ * the per-thread telemetry. All strategies expand nodes through it and
+ * differ only in how open nodes are scheduled.
  */
-void reconstruct_solution(TreeNode* root, TreeNode* best_node, 
-                         Item** best_items, int* best_count) {
-    std::vector<Item> solution_items;
-    std::function<bool(TreeNode*, float, float, std::vector<Item>&)> find_path;
-    
-    // Recursive lambda to find path from root to target node
-    // Matches nodes by their accumulated value and weight
-    find_path = [&](TreeNode* node, float target_value, float target_weight, 
-                     std::vector<Item>& path) -> bool {
-        if (!node) return false;
-        
-        // Found the target node
-        if (node->t_value == target_value && node->t_weight == target_weight) {
-            return true;
-        }
-        
-        // Explore left subtree (item inclusion branch)
-        if (node->left) {
-            if (node->left->included) {
-                path.push_back(node->left->item);
-            }
-            if (find_path(node->left, target_value, target_weight, path)) {
-                return true;
-            }
-            // Backtrack if path not found
-            if (node->left->included) {
-                path.pop_back();
+struct ParallelSearch {
+    Item* items;
+    int n;
+    float capacity;
+    int words;
+    PrefixBound bounds;
+    NodeArena arena;
+
+    // States of pushed nodes, sharded by hash with as many shards as threads;
+    // children dominated by an earlier node at their level are never pushed
+    DominanceTable dominance;
+
+    // Global best solution (shared across threads)
+    // Decision bits of the best solution, guarded by best_lock
+    std::atomic<float> global_best_value;
+    std::vector<uint64_t> global_best_decisions;
+    omp_lock_t best_lock;
+
+    // Per-thread counters, indexed by arena pool (= thread number)
+    SearchTelemetry telemetry;
+
+    // Open nodes, set by the strategy that owns them, for the best open
+    // bound of the incumbent trace
+    WorkDeque* deques;
+    int num_deques;
+    const MultiQueue* frontier;
+
+    ParallelSearch(Item* items, int n, float capacity, int num_threads)
+        : items(items),
+          n(n),
+          capacity(capacity),
+          words(TreeNode::decision_words(n)),
+          bounds(items, n, capacity),
+          arena(num_threads, TreeNode::bytes_for(n)),
+          dominance(capacity, DOMINANCE_TABLE_BYTES, num_threads),
+          global_best_value(0.0f),
+          global_best_decisions(words, 0),
+          telemetry(num_threads),
+          deques(nullptr),
+          num_deques(0),
+          frontier(nullptr) {
+        omp_init_lock(&best_lock);
+
+        // Seed the incumbent with the primal heuristic, so threads can
+        // prune from their first expansion on
+        HeuristicSolution seed;
+        primal_heuristic(items, n, capacity, 0, &seed);
+        print_info("Primal heuristic: %.2f\n", seed.value);
+        global_best_value.store(seed.value, std::memory_order_relaxed);
+        global_best_decisions = seed.decisions;
+    }
+
+    ~ParallelSearch() {
+        omp_destroy_lock(&best_lock);
+    }
+
+    TreeNode* create_root() {
+        TreeNode* root = TreeNode::create_root(arena, 0, words);
+        root->bound = bounds.bound(root);
+        telemetry.record(TRACE_START, -1,
+                         global_best_value.load(std::memory_order_relaxed), root->bound);
+        return root;
+    }
+
+    /**
+     * Expands one node: prunes it or generates its children, updating the
+     * incumbent when the include child improves it. The node itself is
+     * recycled into the calling thread's pool.
+     *
+     * @param current Node to expand
+     * @param pool Arena pool of the calling thread
+     * @param children Output: up to two promising children, exclude branch
+     *                 first, so pushing them in order explores include first
+     * @return Number of children written
+     */
+    int expand(TreeNode* current, int pool, TreeNode** children) {
+        ThreadTelemetry& stats = telemetry.thread(pool);
+        stats.expanded++;
+        if (telemetry.claim_sample(stats.expanded)) {
+            sample_open_bound(pool);
+        }
+
+        float current_best = global_best_value.load(std::memory_order_relaxed);
+
+        // Prune hopeless branches
+        if (!can_improve(current->bound, current_best)) {
+            stats.pruned_bound++;
+            arena.recycle(current, pool);
+            return 0;
+        }
+
+        // Leaf: all items considered
+        if (current->level == n - 1) {
+            stats.leaves++;
+            arena.recycle(current, pool);
+            return 0;
+        }
+
+        int next_level = current->level + 1;
+        TreeNode* left_child = nullptr;
+
+        // Left child: include next item if feasible
+        if (current->t_weight + items[next_level].weight <= capacity) {
+            left_child = current->add(
+                arena, pool, words,
+                true,
+                current->t_weight + items[next_level].weight,
+                current->t_value + items[next_level].value
+            );
+
+            left_child->bound = bounds.bound(left_child);
+
+            // Update best value if improved
+            if (left_child->t_value > current_best) {
+                current_best = offer_incumbent(left_child, pool);
             }
         }
-        
-        // Explore right subtree (item exclusion branch)
-        if (node->right) {
-            if (find_path(node->right, target_value, target_weight, path)) {
-                return true;
+
+        // Right child: exclude next item (always feasible)
+        TreeNode* right_child = current->add(
+            arena, pool, words,
+            false,
+            current->t_weight,
+            current->t_value
+        );
+
+        right_child->bound = bounds.bound(right_child);
+
+        int count = 0;
+        if (admit_child(right_child, current_best, stats)) {
+            children[count++] = right_child;
+        } else {
+            arena.recycle(right_child, pool);
+        }
+        if (left_child) {
+            if (admit_child(left_child, current_best, stats)) {
+                children[count++] = left_child;
+            } else {
+                arena.recycle(left_child, pool);
             }
         }
-        
-        return false;
-    };
-    
-    find_path(root, best_node->t_value, best_node->t_weight, solution_items);
-    
-    *best_count = solution_items.size();
-    for (int i = 0; i < *best_count; i++) {
-        (*best_items)[i] = solution_items[i];
+
+        arena.recycle(current, pool);
+        return count;
+    }
+
+    // Whether a new child is worth pushing, counting why it is not
+    bool admit_child(TreeNode* child, float current_best, ThreadTelemetry& stats) {
+        if (!can_improve(child->bound, current_best)) {
+            stats.pruned_children++;
+            return false;
+        }
+        if (!dominance.admit(child)) {
+            stats.dominated++;
+            return false;
+        }
+        return true;
+    }
+
+    // Installs node as the incumbent if it still beats it; returns the
+    // incumbent value afterwards
+    float offer_incumbent(TreeNode* node, int thread) {
+        omp_set_lock(&best_lock);
+        float global_val = global_best_value.load(std::memory_order_relaxed);
+        if (node->t_value > global_val) {
+            global_best_value.store(node->t_value, std::memory_order_relaxed);
+            std::copy(node->decisions(), node->decisions() + words,
+                      global_best_decisions.begin());
+            global_val = node->t_value;
+            telemetry.record(TRACE_IMPROVEMENT, thread, global_val, -1.0f);
+        }
+        omp_unset_lock(&best_lock);
+        return global_val;
+    }
+
+    // Appends a trace sample of the open bound. The queues are scanned
+    // before taking best_lock, which only serializes the append
+    void sample_open_bound(int thread) {
+        if (num_deques == 0 && !frontier) {
+            return;
+        }
+        float open = open_bound();
+        omp_set_lock(&best_lock);
+        telemetry.record(TRACE_SAMPLE, thread,
+                         global_best_value.load(std::memory_order_relaxed), open);
+        omp_unset_lock(&best_lock);
+    }
+
+    /**
+     * Best bound among the queued nodes (nodes being expanded are not
+     * seen), or -1 if none are queued or the strategy's queue is not
+     * visible (OpenMP tasks).
+     */
+    float open_bound() {
+        float best = -1.0f;
+        for (int d = 0; d < num_deques; d++) {
+            best = std::max(best, deques[d].best_bound());
+        }
+        if (frontier) {
+            best = std::max(best, frontier->best_bound());
+        }
+        return best;
+    }
+
+    // Reports statistics and reads the solution off the incumbent's bits
+    void finish(float* max_value, Item** best_items, int* best_count,
+                int* nodes_explored_out, int* nodes_pruned_out) {
+        ThreadTelemetry total = telemetry.total();
+        int explored = (int)std::min<long long>(total.expanded, INT32_MAX);
+        int pruned   = (int)std::min<long long>(total.pruned_bound, INT32_MAX);
+        print_statistics(explored, pruned);
+        dominance.report();
+        telemetry.report();
+        float best = global_best_value.load(std::memory_order_relaxed);
+        telemetry.record(TRACE_FINISH, -1, best, best);
+        telemetry.write_trace();
+        if (nodes_explored_out) {
+            *nodes_explored_out = explored;
+        }
+        if (nodes_pruned_out) {
+            *nodes_pruned_out = pruned;
+        }
+
+        *max_value = global_best_value.load(std::memory_order_relaxed);
+        *best_items = new Item[n];
+        *best_count = collect_solution(global_best_decisions.data(), items, n, *best_items);
+    }
+};
+
+/**
+ * Searches a subtree depth-first on the calling thread with an explicit
+ * stack (used by tasks below the cutoff depth).
+ */
+void dive(ParallelSearch& search, TreeNode* start) {
+    std::vector<TreeNode*> stack;
+    stack.push_back(start);
+    TreeNode* children[2];
+
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+
+        int thread_id = omp_get_thread_num();
+        int count = search.expand(current, thread_id, children);
+        for (int i = 0; i < count; i++) {
+            stack.push_back(children[i]);
+        }
+        ThreadTelemetry& stats = search.telemetry.thread(thread_id);
+        stats.queue_high_water = std::max(stats.queue_high_water, (long long)stack.size());
+    }
+}
+
+/**
+ * Task-parallel recursion: above the cutoff depth every promising child
+ * becomes its own OpenMP task; at the cutoff the subtree is finished
+ * sequentially inside the current task.
+ */
+void spawn(ParallelSearch& search, TreeNode* node, int cutoff) {
+    if (node->level + 1 >= cutoff) {
+        dive(search, node);
+        return;
+    }
+
+    TreeNode* children[2];
+    int count = search.expand(node, omp_get_thread_num(), children);
+
+    // Include branch (last) first: it tends to raise the incumbent early
+    for (int i = count - 1; i >= 0; i--) {
+        TreeNode* child = children[i];
+        #pragma omp task firstprivate(child) shared(search)
+        spawn(search, child, cutoff);
     }
 }
 
+/**
+ * Value of the greedy solution: items in ratio order, each taken if it
+ * still fits. A cheap lower bound used to gauge instance difficulty.
+ */
+float greedy_value(const Item* items, int n, float capacity) {
+    float weight = 0.0f;
+    float value = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (weight + items[i].weight <= capacity) {
+            weight += items[i].weight;
+            value += items[i].value;
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+/**
+ * Chooses how deep the task-parallel search keeps spawning tasks.
+ *
+ * The base depth yields about eight tasks per thread. A large relative gap
+ * between the root bound and the greedy solution means weak pruning near
+ * the root and a more irregular tree, so a few extra levels are added to
+ * give the runtime more, smaller tasks to balance. The cutoff never exceeds
+ * half the items, so every task still carries a meaningful subtree.
+ *
+ * @param n Number of items
+ * @param num_threads Number of worker threads
+ * @param root_bound Upper bound at the root
+ * @param greedy Value of the greedy solution (lower bound)
+ * @return Level at which tasks switch to sequential depth-first search
+ */
+int choose_task_cutoff(int n, int num_threads, float root_bound, float greedy) {
+    int cutoff = 3;
+    for (int t = 1; t < num_threads; t *= 2) {
+        cutoff++;
+    }
+
+    float gap = root_bound > 0.0f ? (root_bound - greedy) / root_bound : 0.0f;
+    if (gap > 0.0f) {
+        cutoff += (int)(log2(1.0 + gap * 1000.0) / 2.0);
+    }
+
+    return std::max(1, std::min(cutoff, n / 2));
+}
+
+namespace {
+
 /**
  * Parallel Branch and Bound algorithm for 0/1 Knapsack Problem using OpenMP.
- * 
- * Uses best-first search with a thread-safe priority queue to explore promising nodes first.
- * Multiple worker threads extract nodes, calculate bounds, generate children, and update
- * the global best solution concurrently.
- * 
+ *
+ * Uses work stealing over per-thread deques of open nodes. Each thread
+ * searches depth-first from the back of its own deque; a thread that runs
+ * out of work steals the shallowest node from another thread's deque. Every
+ * open node is owned by exactly one deque, so subtrees are never searched
+ * twice and the node count stays close to a single-threaded search.
+ *
  * Algorithm steps:
  * 1. Sort items by value/weight ratio (greedy heuristic)
- * 2. Initialize shared queue with root node (empty knapsack)
+ * 2. Place the root node (empty knapsack) in thread 0's deque
  * 3. Launch worker threads that:
- *    - Extract most promising node (highest bound)
+ *    - Pop their deepest open node, or steal a shallow one when empty
  *    - Generate children: include next item (if feasible) and exclude next item
  *    - Prune branches with bound <= current best
- *    - Update global best solution atomically
- * 4. Continue until queue is empty and all threads are idle
- * 
+ *    - Update global best solution under a lock
+ * 4. Stop once every thread is idle (all deques empty, nothing in progress)
+ *
  * @param items Array of available items
  * @param n Number of items
  * @param capacity Maximum knapsack capacity
@@ -90,165 +374,300 @@ void reconstruct_solution(TreeNode* root, TreeNode* best_node,
  * @param best_items Output: array of selected items
  * @param best_count Output: number of selected items
  * @param num_threads Number of worker threads to use
- * @return Root of the search tree (for solution reconstruction)
  */
-TreeNode* branch_and_bound_parallel(Item* items, int n, float capacity, 
-                                   float* max_value, Item** best_items, 
-                                   int* best_count, int num_threads,
-                                   int* nodes_explored_out, int* nodes_pruned_out) {
-    // Shallow tasking cutoff to prevent creating tiny tasks deep in the tree
-    const int TASK_CUTOFF_LEVEL = 12;
-    
+void steal_search(Item* items, int n, float capacity,
+                  float* max_value, Item** best_items,
+                  int* best_count, int num_threads,
+                  int* nodes_explored_out, int* nodes_pruned_out) {
     // Sort items by value/weight ratio (descending)
     // This improves bound quality and pruning effectiveness
-    std::sort(items, items + n, compare_items);
+    sort_items(items, n);
     print_sorted_items(items, n);
-    
-    // Global best solution (shared across threads)
-    std::atomic<float> global_best_value(0.0f);
-    TreeNode* global_best_node = nullptr;
-    omp_lock_t best_lock;
-    omp_init_lock(&best_lock);
-    
-    // Initialize root node representing empty knapsack
-    TreeNode* root = new TreeNode();
-    root->level = -1;
-    root->t_value = 0.0f;
-    root->t_weight = 0.0f;
-    root->bound = calculate_bound(root, items, n, capacity);
-    
-    global_best_node = root;
-    
-    std::atomic<int> nodes_explored(0);
-    std::atomic<int> nodes_pruned(0);
-
-    // Helper: explore a subtree using a local priority queue (best-first search)
-    auto explore_subtree = [&](TreeNode* start_node) {
-        std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> pq;
-        pq.push(start_node);
-
-        while (!pq.empty()) {
-            TreeNode* current = pq.top();
-            pq.pop();
-
-            nodes_explored.fetch_add(1, std::memory_order_relaxed);
-
-            float current_best = global_best_value.load(std::memory_order_relaxed);
-
-            // Prune hopeless branches
-            if (current->bound <= current_best) {
-                nodes_pruned.fetch_add(1, std::memory_order_relaxed);
-                continue;
-            }
 
-            // Leaf: all items considered
-            if (current->level == n - 1) {
-                continue;
-            }
+    // One arena pool per thread: allocation never contends on the heap.
+    // Nodes carry their own decision bits and are recycled into the pool of
+    // the thread that finishes with them; the rest go when the search returns
+    ParallelSearch search(items, n, capacity, num_threads);
 
-            int next_level = current->level + 1;
-
-            // Left child: include next item if feasible
-            if (current->t_weight + items[next_level].weight <= capacity) {
-                TreeNode* left_child = current->add(
-                    true,
-                    items[next_level],
-                    current->t_weight + items[next_level].weight,
-                    current->t_value + items[next_level].value,
-                    next_level
-                );
-
-                left_child->bound = calculate_bound(left_child, items, n, capacity);
-
-                // Update best value if improved
-                if (left_child->t_value > current_best) {
-                    omp_set_lock(&best_lock);
-                    float global_val = global_best_value.load(std::memory_order_relaxed);
-                    if (left_child->t_value > global_val) {
-                        global_best_value.store(left_child->t_value, std::memory_order_relaxed);
-                        global_best_node = left_child;
-                        current_best = left_child->t_value;
+    // Open nodes, one deque per thread; the search starts in thread 0's
+    WorkDeque* deques = new WorkDeque[num_threads];
+    std::atomic<int> idle_threads(0);
+    search.deques = deques;
+    search.num_deques = num_threads;
+
+    deques[0].push(search.create_root());
+
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    {
+        int thread_id = omp_get_thread_num();
+        int team_size = omp_get_num_threads();
+        WorkDeque& own = deques[thread_id];
+        ThreadTelemetry& stats = search.telemetry.thread(thread_id);
+        TreeNode* children[2];
+
+        // xorshift state for picking steal victims
+        unsigned int rng = 2463534242u ^ (unsigned int)(thread_id * 2654435761u);
+        bool idle = false;
+        double idle_since = 0.0;
+
+        while (true) {
+            TreeNode* current = own.pop();
+
+            if (!current) {
+                if (!idle) {
+                    idle = true;
+                    idle_since = search.telemetry.elapsed();
+                    idle_threads.fetch_add(1);
+                }
+
+                // Try every other thread once, starting at a random victim
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                int start = team_size > 1 ? (int)(rng % (unsigned int)team_size) : 0;
+                for (int k = 0; k < team_size && !current; k++) {
+                    int victim = (start + k) % team_size;
+                    if (victim != thread_id) {
+                        current = deques[victim].steal(idle_threads);
+                        if (current) {
+                            stats.steals++;
+                        } else {
+                            stats.failed_steals++;
+                        }
                     }
-                    omp_unset_lock(&best_lock);
                 }
 
-                // Add to local queue only if bound is promising
-                if (left_child->bound > current_best) {
-                    pq.push(left_child);
+                if (!current) {
+                    // Everyone idle means every deque is empty: done
+                    if (idle_threads.load() == team_size) {
+                        stats.idle_seconds += search.telemetry.elapsed() - idle_since;
+                        break;
+                    }
+                    continue;
                 }
+                idle = false;
+                stats.idle_seconds += search.telemetry.elapsed() - idle_since;
             }
 
-            // Right child: exclude next item (always feasible)
-            TreeNode* right_child = current->add(
-                false,
-                items[next_level],
-                current->t_weight,
-                current->t_value,
-                next_level
-            );
-
-            right_child->bound = calculate_bound(right_child, items, n, capacity);
-
-            if (right_child->bound > current_best) {
-                pq.push(right_child);
+            // Push the exclude branch first so the include branch is popped
+            // next: each thread dives greedily down its subtree
+            int count = search.expand(current, thread_id, children);
+            for (int i = 0; i < count; i++) {
+                own.push(children[i]);
             }
+            stats.queue_high_water = std::max(stats.queue_high_water, (long long)own.size());
         }
-    };
+    }
+
+    search.finish(max_value, best_items, best_count,
+                  nodes_explored_out, nodes_pruned_out);
+    delete[] deques;
+}
+
+/**
+ * Task-parallel Branch and Bound for 0/1 Knapsack using OpenMP tasks.
+ *
+ * The top of the tree is expanded recursively with one `omp task` per
+ * promising child, down to a cutoff depth chosen by choose_task_cutoff from
+ * the instance size, the thread count and the root bound gap. Each task at
+ * the cutoff finishes its subtree with a sequential depth-first search. The
+ * OpenMP runtime balances the tasks; all tasks share the incumbent.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param num_threads Number of worker threads to use
+ */
+void task_search(Item* items, int n, float capacity,
+                 float* max_value, Item** best_items,
+                 int* best_count, int num_threads,
+                 int* nodes_explored_out, int* nodes_pruned_out) {
+    // Sort items by value/weight ratio (descending)
+    sort_items(items, n);
+    print_sorted_items(items, n);
+
+    ParallelSearch search(items, n, capacity, num_threads);
+    TreeNode* root = search.create_root();
+
+    int cutoff = choose_task_cutoff(n, num_threads, root->bound,
+                                    greedy_value(items, n, capacity));
+    print_info("Task cutoff level: %d\n", cutoff);
+
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    {
+        #pragma omp single
+        spawn(search, root, cutoff);
+    }
+
+    search.finish(max_value, best_items, best_count,
+                  nodes_explored_out, nodes_pruned_out);
+}
+
+/**
+ * Shared best-first Branch and Bound for 0/1 Knapsack using OpenMP.
+ *
+ * All threads draw from one relaxed concurrent priority queue (MultiQueue)
+ * instead of private frontiers, so every thread works on one of the most
+ * promising open nodes and the search order stays close to the sequential
+ * best-first order. This avoids expanding nodes that a private queue would
+ * pick only because the globally better ones sit in another thread's queue.
+ *
+ * The search ends when no node is queued or being expanded: a node counts as
+ * pending from its push until its children have been pushed.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param num_threads Number of worker threads to use
+ */
+void multiqueue_search(Item* items, int n, float capacity,
+                       float* max_value, Item** best_items,
+                       int* best_count, int num_threads,
+                       int* nodes_explored_out, int* nodes_pruned_out) {
+    // Sort items by value/weight ratio (descending)
+    sort_items(items, n);
+    print_sorted_items(items, n);
+
+    ParallelSearch search(items, n, capacity, num_threads);
+
+    MultiQueue frontier(num_threads);
+    std::atomic<int> pending(1);
+    search.frontier = &frontier;
+
+    unsigned int root_rng = 2463534242u;
+    frontier.push(search.create_root(), root_rng);
 
-    // Parallel region: each thread explores a different starting pattern
     omp_set_num_threads(num_threads);
     #pragma omp parallel
     {
         int thread_id = omp_get_thread_num();
+        unsigned int rng = 2463534242u ^ (unsigned int)((thread_id + 1) * 2654435761u);
+        ThreadTelemetry& stats = search.telemetry.thread(thread_id);
+        TreeNode* children[2];
+        bool idle = false;
+        double idle_since = 0.0;
 
-        // Simple distribution of initial decisions based on thread ID
-        TreeNode* start_node = root;
-        if (thread_id > 0) {
-            int start_pattern = thread_id % 4;
-            start_node = root;
-
-            for (int i = 0; i < start_pattern && i < n; ++i) {
-                if (start_node->t_weight + items[i].weight <= capacity) {
-                    start_node = start_node->add(
-                        true,
-                        items[i],
-                        start_node->t_weight + items[i].weight,
-                        start_node->t_value + items[i].value,
-                        i
-                    );
-                } else {
-                    start_node = start_node->add(
-                        false,
-                        items[i],
-                        start_node->t_weight,
-                        start_node->t_value,
-                        i
-                    );
+        while (true) {
+            TreeNode* current = frontier.pop(rng);
+            if (!current) {
+                if (!idle) {
+                    idle = true;
+                    idle_since = search.telemetry.elapsed();
+                }
+                // Empty and nothing in flight: the search is complete
+                if (pending.load() == 0) {
+                    stats.idle_seconds += search.telemetry.elapsed() - idle_since;
+                    break;
                 }
-                start_node->bound = calculate_bound(start_node, items, n, capacity);
+                continue;
+            }
+            if (idle) {
+                idle = false;
+                stats.idle_seconds += search.telemetry.elapsed() - idle_since;
             }
-        }
 
-        explore_subtree(start_node);
+            // Queue size here is the open node count of the shared frontier
+            int count = search.expand(current, thread_id, children);
+            int open = pending.fetch_add(count) + count;
+            stats.queue_high_water = std::max(stats.queue_high_water, (long long)open);
+            for (int i = 0; i < count; i++) {
+                frontier.push(children[i], rng);
+            }
+            pending.fetch_sub(1);
+        }
     }
 
-    omp_destroy_lock(&best_lock);
+    search.finish(max_value, best_items, best_count,
+                  nodes_explored_out, nodes_pruned_out);
+}
 
-    int explored = nodes_explored.load();
-    int pruned   = nodes_pruned.load();
-    print_statistics(explored, pruned);
+/**
+ * Runs a search strategy on the items left free by reduced-cost variable
+ * fixing (see variable_fixing.h), or on all items if fixing is off, and
+ * returns the solution of the full problem.
+ */
+void solve_fixed(ParallelSolver strategy, Item* items, int n, float capacity,
+                 float* max_value, Item** best_items,
+                 int* best_count, int num_threads,
+                 int* nodes_explored_out, int* nodes_pruned_out) {
+    if (!variable_fixing()) {
+        strategy(items, n, capacity, max_value, best_items, best_count,
+                 num_threads, nodes_explored_out, nodes_pruned_out);
+        return;
+    }
+
+    // Nothing is searched if every item is fixed
     if (nodes_explored_out) {
-        *nodes_explored_out = explored;
+        *nodes_explored_out = 0;
     }
     if (nodes_pruned_out) {
-        *nodes_pruned_out = pruned;
+        *nodes_pruned_out = 0;
     }
 
-    // Reconstruct the solution by tracing path from root to best_node
-    *max_value = global_best_value.load(std::memory_order_relaxed);
-    *best_items = new Item[n];
-    *best_count = 0;
-    reconstruct_solution(root, global_best_node, best_items, best_count);
+    ReducedProblem reduced;
+    fix_variables(items, n, capacity, &reduced);
+    solve_reduced(&reduced, n, max_value, best_items, best_count,
+                  [&](Item* free_items, int free_count, float free_capacity,
+                      float* value, Item** chosen, int* chosen_count) {
+                      strategy(free_items, free_count, free_capacity, value, chosen,
+                               chosen_count, num_threads, nodes_explored_out,
+                               nodes_pruned_out);
+                  });
+}
 
-    return root;
+} // namespace
+
+// Work stealing strategy (steal_search) behind variable fixing
+void branch_and_bound_parallel(Item* items, int n, float capacity,
+                               float* max_value, Item** best_items,
+                               int* best_count, int num_threads,
+                               int* nodes_explored_out, int* nodes_pruned_out) {
+    solve_fixed(steal_search, items, n, capacity, max_value, best_items, best_count,
+                num_threads, nodes_explored_out, nodes_pruned_out);
+}
+
+// Task strategy (task_search) behind variable fixing
+void branch_and_bound_tasks(Item* items, int n, float capacity,
+                            float* max_value, Item** best_items,
+                            int* best_count, int num_threads,
+                            int* nodes_explored_out, int* nodes_pruned_out) {
+    solve_fixed(task_search, items, n, capacity, max_value, best_items, best_count,
+                num_threads, nodes_explored_out, nodes_pruned_out);
+}
+
+// Shared best-first strategy (multiqueue_search) behind variable fixing
+void branch_and_bound_multiqueue(Item* items, int n, float capacity,
+                                 float* max_value, Item** best_items,
+                                 int* best_count, int num_threads,
+                                 int* nodes_explored_out, int* nodes_pruned_out) {
+    solve_fixed(multiqueue_search, items, n, capacity, max_value, best_items, best_count,
+                num_threads, nodes_explored_out, nodes_pruned_out);
+}
+
+/**
+ * Maps a strategy name to its search function.
+ *
+ * @param strategy "steal" (work stealing), "tasks" (OpenMP tasks) or
+ *                 "multiqueue" (shared relaxed priority queue)
+ * @return The matching solver, or nullptr if the name is unknown
+ */
+ParallelSolver parallel_solver_for(const char* strategy) {
+    if (strcmp(strategy, "steal") == 0) {
+        return branch_and_bound_parallel;
+    }
+    if (strcmp(strategy, "tasks") == 0) {
+        return branch_and_bound_tasks;
+    }
+    if (strcmp(strategy, "multiqueue") == 0) {
+        return branch_and_bound_multiqueue;
+    }
+    return nullptr;
 }
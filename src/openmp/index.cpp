@@ -13,6 +13,7 @@
 #include <omp.h>
 #include "parser/parser.h"
 #include "branch_and_bound_parallel.h"
+#include "search_telemetry.h"
 #include "test_config.h"
 
 int main(int argc, char* argv[]) {
@@ -25,6 +26,19 @@ int main(int argc, char* argv[]) {
             return 1;
         }
     }
+
+    // Optional scheduling strategy: steal (default), tasks or multiqueue
+    const char* strategy = argc > 2 ? argv[2] : "steal";
+    ParallelSolver solver = parallel_solver_for(strategy);
+    if (solver == nullptr) {
+        printf("Error: Unknown strategy '%s' (expected steal, tasks or multiqueue)\n", strategy);
+        return 1;
+    }
+
+    // Optional CSV file for the incumbent trace
+    if (argc > 3) {
+        set_search_trace_file(argv[3]);
+    }
     
     // Load items and capacity from input file
     int item_count = 0;
@@ -39,7 +53,8 @@ int main(int argc, char* argv[]) {
     printf("Test file: %s\n", TEST_FILE);
     printf("Loaded %d items from data file.\n", item_count);
     printf("Knapsack capacity: %.2f\n", capacity);
-    printf("Number of threads: %d\n\n", num_threads);
+    printf("Number of threads: %d\n", num_threads);
+    printf("Strategy: %s\n\n", strategy);
     
     // Initialize solution variables
     float max_value = 0.0f;
@@ -47,9 +62,9 @@ int main(int argc, char* argv[]) {
     int best_count = 0;
     
     // Execute parallel branch and bound algorithm
-    TreeNode* solution_tree = branch_and_bound_parallel(items, item_count, capacity, 
-                                                       &max_value, &best_items, &best_count, 
-                                                       num_threads);
+    solver(items, item_count, capacity, 
+           &max_value, &best_items, &best_count, 
+           num_threads, nullptr, nullptr);
     
     // Display optimal solution
     printf("\n========== OPTIMAL SOLUTION ==========\n");
@@ -68,7 +83,6 @@ int main(int argc, char* argv[]) {
     printf("======================================\n");
     
     // Free dynamically allocated memory
-    delete solution_tree;
     delete[] best_items;
     delete[] items;
     
@@ -1,117 +1,146 @@
 /**
  * MPI Branch and Bound implementation for 0/1 Knapsack
  *
- * Uses MPI for distributed computing with sequential execution on rank 0
- * and result broadcasting to all processes.
+ * Every rank runs a best-first search over its own share of the tree. Work
+ * is balanced dynamically: a rank whose queue runs dry asks a random rank
+ * for work, and the victim ships part of its open frontier in the compact
+ * node format of node_codec.h. Incumbent values are shared through an RMA
+ * window (incumbent_window.h) as they are found. Termination is detected
+ * with Safra's token ring, and the winning rank broadcasts the solution at
+ * the end.
  */
 
 #include <mpi.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
 #include <algorithm>
 #include <queue>
 #include <vector>
-#include <functional>
-#include <atomic>
 #include "branch_and_bound_mpi.h"
+#include "incumbent_window.h"
 #include "knapsack_utils.h"
+#include "prefix_bound.h"
+#include "node_codec.h"
 #include "output_display.h"
+#include "primal_heuristic.h"
 #include "tree_node.h"
-#include "branch_and_bound.h"  // For CompareNode comparator
 
 namespace {
 
-void reconstruct_solution(TreeNode* root, TreeNode* best_node,
-                         std::vector<Item>& solution_items) {
-    std::function<bool(TreeNode*, float, float, std::vector<Item>&)> find_path;
-    
-    find_path = [&](TreeNode* node, float target_value, float target_weight,
-                     std::vector<Item>& path) -> bool {
-        if (!node) return false;
-        
-        if (node->t_value == target_value && node->t_weight == target_weight) {
-            return true;
-        }
-        
-        if (node->left) {
-            if (node->left->included) {
-                path.push_back(node->left->item);
-            }
-            if (find_path(node->left, target_value, target_weight, path)) {
-                return true;
-            }
-            if (node->left->included) {
-                path.pop_back();
-            }
-        }
-        
-        if (node->right) {
-            if (find_path(node->right, target_value, target_weight, path)) {
-                return true;
-            }
-        }
-        
-        return false;
-    };
-    
-    find_path(root, best_node->t_value, best_node->t_weight, solution_items);
-}
+// Message tags of the load-balancing protocol
+const int TAG_WORK_REQUEST = 1;  // Idle rank asks for work: [incumbent]
+const int TAG_WORK = 2;          // Reply: [incumbent, count, count records]
+const int TAG_TOKEN = 3;         // Termination token: [message count, color]
+const int TAG_DONE = 4;          // Rank 0 announces termination
 
-} // namespace
+// Expansions between checks for incoming messages and the global incumbent
+const int POLL_INTERVAL = 64;
 
-void branch_and_bound_mpi(Item* items,
-                          int item_count,
-                          float capacity,
-                          float* global_best_value,
-                          Item** best_items,
-                          int* best_count,
-                          MpiStats* stats,
-                          MPI_Comm comm) {
-    int world_rank = 0;
-    int world_size = 1;
-    MPI_Comm_rank(comm, &world_rank);
-    MPI_Comm_size(comm, &world_size);
+// Open nodes each rank should get from the initial split
+const int INITIAL_NODES_PER_RANK = 4;
 
-    if (item_count == 0) {
-        if (global_best_value) *global_best_value = 0.0f;
-        if (best_items) *best_items = nullptr;
-        if (best_count) *best_count = 0;
-        if (stats) {
-            stats->nodes_explored = 0;
-            stats->nodes_pruned = 0;
-        }
-        return;
-    }
+// Upper limit on the nodes shipped in answer to one request
+const int MAX_SHIPPED_NODES = 256;
 
-    // Sort items
-    std::sort(items, items + item_count, compare_items);
-    if (world_rank == 0) {
-        print_sorted_items(items, item_count);
-    }
+typedef std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> NodeQueue;
 
-float local_best_value = 0.0f;
-TreeNode* best_node = nullptr;
-TreeNode* best_root = nullptr;
-std::atomic<long long> local_nodes_explored(0);
-std::atomic<long long> local_nodes_pruned(0);
+uint64_t pack_value(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
 
-// Helper: best-first search using a local priority queue on this rank,
-// starting from the given node within the provided tree root.
-auto explore_with_pq = [&](TreeNode* root, TreeNode* start_node) {
-    std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> pq;
-    pq.push(start_node);
+float unpack_value(uint64_t word) {
+    uint32_t bits = (uint32_t)word;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
 
-    while (!pq.empty()) {
+/**
+ * Search state of one rank: local best-first queue, incumbent, and the
+ * bookkeeping for work requests and Safra's termination algorithm.
+ */
+struct RankSearch {
+    Item* items;
+    int n;
+    float capacity;
+    int words;
+    const PrefixBound& bounds;
+    NodeArena arena;
+    NodeQueue pq;
+
+    int rank;
+    int size;
+    MPI_Comm comm;
+
+    // Best value known on this rank (own or received from other ranks)
+    float best_value;
+    // Global incumbent shared by all ranks
+    IncumbentWindow& incumbent;
+    // Decision bits and value of the best solution this rank found itself
+    std::vector<uint64_t> best_decisions;
+    float own_best_value;
+
+    long long nodes_explored;
+    long long nodes_pruned;
+
+    // Work transfer and termination state
+    bool request_outstanding;
+    long long message_count;   // Work messages sent minus received (Safra)
+    bool black;                // Received work since the token last passed
+    bool have_token;
+    long long token_count;
+    bool token_black;
+    bool token_started;
+    bool done;
+    unsigned int rng;
+
+    RankSearch(Item* items, int n, float capacity, const PrefixBound& bounds,
+               IncumbentWindow& incumbent, MPI_Comm comm)
+        : items(items),
+          n(n),
+          capacity(capacity),
+          words(TreeNode::decision_words(n)),
+          bounds(bounds),
+          arena(1, TreeNode::bytes_for(n)),
+          comm(comm),
+          best_value(0.0f),
+          incumbent(incumbent),
+          best_decisions(words, 0),
+          own_best_value(0.0f),
+          nodes_explored(0),
+          nodes_pruned(0),
+          request_outstanding(false),
+          message_count(0),
+          black(false),
+          have_token(false),
+          token_count(0),
+          token_black(false),
+          token_started(false),
+          done(false) {
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        rng = 2463534242u ^ (unsigned int)((rank + 1) * 2654435761u);
+    }
+
+    // Pops and expands the best local node, pushing promising children
+    void expand_next() {
         TreeNode* current = pq.top();
         pq.pop();
 
-        local_nodes_explored.fetch_add(1, std::memory_order_relaxed);
+        nodes_explored++;
 
-        if (current->bound <= local_best_value) {
-            local_nodes_pruned.fetch_add(1, std::memory_order_relaxed);
-            continue;
+        if (!can_improve(current->bound, best_value)) {
+            nodes_pruned++;
+            arena.recycle(current);
+            return;
         }
 
-        if (current->level == item_count - 1) {
-            continue;
+        if (current->level == n - 1) {
+            arena.recycle(current);
+            return;
         }
 
         int next_level = current->level + 1;
@@ -119,147 +148,338 @@ auto explore_with_pq = [&](TreeNode* root, TreeNode* start_node) {
         // Left child (include item)
         if (current->t_weight + items[next_level].weight <= capacity) {
             TreeNode* left_child = current->add(
-                true, items[next_level],
+                arena, 0, words, true,
                 current->t_weight + items[next_level].weight,
-                current->t_value + items[next_level].value,
-                next_level
+                current->t_value + items[next_level].value
             );
 
-            left_child->bound = calculate_bound(left_child, items, item_count, capacity);
+            left_child->bound = bounds.bound(left_child);
 
-            if (left_child->t_value > local_best_value) {
-                local_best_value = left_child->t_value;
-                best_node = left_child;
-                best_root = root;
+            if (left_child->t_value > best_value) {
+                best_value = left_child->t_value;
+                own_best_value = left_child->t_value;
+                std::copy(left_child->decisions(), left_child->decisions() + words,
+                          best_decisions.begin());
+                incumbent.publish(best_value);
             }
 
-            if (left_child->bound > local_best_value) {
+            if (can_improve(left_child->bound, best_value)) {
                 pq.push(left_child);
+            } else {
+                arena.recycle(left_child);
             }
         }
 
         // Right child (exclude item)
         TreeNode* right_child = current->add(
-            false, items[next_level],
-            current->t_weight, current->t_value,
-            next_level
+            arena, 0, words, false,
+            current->t_weight, current->t_value
         );
 
-        right_child->bound = calculate_bound(right_child, items, item_count, capacity);
+        right_child->bound = bounds.bound(right_child);
 
-        if (right_child->bound > local_best_value) {
+        if (can_improve(right_child->bound, best_value)) {
             pq.push(right_child);
+        } else {
+            arena.recycle(right_child);
         }
+
+        arena.recycle(current);
     }
-};
 
-    // Partition the search tree across ranks using fixed decision prefixes.
-    // We take the first prefix_bits items and assign each of the 2^prefix_bits
-    // include/exclude patterns round-robin to MPI ranks.
-    // Using a small prefix (2) limits duplicate work and keeps pruning effective.
-    int prefix_bits = std::min(2, item_count);  // up to 4 disjoint prefixes
-    int total_patterns = 1 << prefix_bits;
-
-    for (int pattern = 0; pattern < total_patterns; ++pattern) {
-        if (pattern % world_size != world_rank) {
-            // This rank skips patterns assigned to other ranks, but still
-            // participates in the global best-value synchronization below.
-            // (local_best_value remains whatever it was from previous work.)
-        } else {
+    /**
+     * Splits the top of the tree without communication. Every rank expands
+     * the same best-first prefix of the search until there are a few open
+     * nodes per rank, then keeps every size-th node in best-first order, so
+     * all ranks start with work of similar quality. Only rank 0 counts the
+     * prefix's nodes, so the job totals include them once.
+     */
+    void initial_split() {
+        TreeNode* root = TreeNode::create_root(arena, 0, words);
+        root->bound = bounds.bound(root);
+        pq.push(root);
+
+        if (size == 1) {
+            return;
+        }
 
-            // Fresh tree for this pattern
-            TreeNode* root = new TreeNode();
-            root->level = -1;
-            root->t_value = 0.0f;
-            root->t_weight = 0.0f;
-            root->bound = calculate_bound(root, items, item_count, capacity);
-
-            TreeNode* start_node = root;
-            bool pruned_prefix = false;
-
-            // Apply prefix decisions according to bits of 'pattern'
-            for (int lvl = 0; lvl < prefix_bits; ++lvl) {
-                int item_index = lvl;
-                bool include = (pattern & (1 << lvl)) != 0;
-
-                if (include && start_node->t_weight + items[item_index].weight <= capacity) {
-                    start_node = start_node->add(
-                        true, items[item_index],
-                        start_node->t_weight + items[item_index].weight,
-                        start_node->t_value + items[item_index].value,
-                        item_index
-                    );
-                } else {
-                    // Either exclude by choice or because including would overflow
-                    start_node = start_node->add(
-                        false, items[item_index],
-                        start_node->t_weight,
-                        start_node->t_value,
-                        item_index
-                    );
-                }
-                start_node->bound = calculate_bound(start_node, items, item_count, capacity);
+        while (!pq.empty() && (int)pq.size() < size * INITIAL_NODES_PER_RANK) {
+            expand_next();
+        }
+        if (rank != 0) {
+            nodes_explored = 0;
+            nodes_pruned = 0;
+        }
 
-                if (start_node->bound <= local_best_value) {
-                    // Entire subtree under this prefix cannot beat current best for this rank
-                    pruned_prefix = true;
+        std::vector<TreeNode*> mine;
+        for (int index = 0; !pq.empty(); index++) {
+            TreeNode* node = pq.top();
+            pq.pop();
+            if (index % size == rank) {
+                mine.push_back(node);
+            } else {
+                arena.recycle(node);
+            }
+        }
+        for (size_t i = 0; i < mine.size(); i++) {
+            pq.push(mine[i]);
+        }
+    }
+
+    void absorb_incumbent(float value) {
+        if (value > best_value) {
+            best_value = value;
+        }
+    }
+
+    // Starts from a heuristic solution as this rank's own best
+    void seed_incumbent(const HeuristicSolution& seed) {
+        best_value = seed.value;
+        own_best_value = seed.value;
+        best_decisions = seed.decisions;
+    }
+
+    // Answers a work request with up to half of the local queue
+    void answer_request(int requester) {
+        std::vector<uint64_t> reply;
+        reply.push_back(pack_value(best_value));
+        reply.push_back(0);
+
+        // Alternate between shipping and keeping the best nodes, so both
+        // ranks continue with work of similar promise
+        int ship = std::min((int)pq.size() / 2, MAX_SHIPPED_NODES);
+        std::vector<TreeNode*> kept;
+        int shipped = 0;
+        while (shipped < ship) {
+            TreeNode* node = pq.top();
+            pq.pop();
+            if (!can_improve(node->bound, best_value)) {
+                nodes_pruned++;
+                arena.recycle(node);
+                if (pq.empty()) {
                     break;
                 }
+                continue;
             }
+            encode_node(node, words, reply);
+            arena.recycle(node);
+            shipped++;
 
-            if (pruned_prefix) {
-                delete root;
+            if (pq.empty()) {
+                break;
+            }
+            kept.push_back(pq.top());
+            pq.pop();
+            if (pq.empty()) {
+                break;
+            }
+        }
+        for (size_t i = 0; i < kept.size(); i++) {
+            pq.push(kept[i]);
+        }
+
+        reply[1] = (uint64_t)shipped;
+        if (shipped > 0) {
+            message_count++;
+        }
+        MPI_Send(reply.data(), (int)reply.size(), MPI_UINT64_T, requester, TAG_WORK, comm);
+    }
+
+    // Handles every message that has arrived, without blocking
+    void poll() {
+        int flag = 0;
+        MPI_Status status;
+        while (true) {
+            MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &flag, &status);
+            if (!flag) {
+                return;
+            }
+
+            if (status.MPI_TAG == TAG_WORK_REQUEST) {
+                uint64_t incumbent = 0;
+                MPI_Recv(&incumbent, 1, MPI_UINT64_T, status.MPI_SOURCE,
+                         TAG_WORK_REQUEST, comm, MPI_STATUS_IGNORE);
+                absorb_incumbent(unpack_value(incumbent));
+                answer_request(status.MPI_SOURCE);
+            } else if (status.MPI_TAG == TAG_WORK) {
+                int length = 0;
+                MPI_Get_count(&status, MPI_UINT64_T, &length);
+                std::vector<uint64_t> message(length);
+                MPI_Recv(message.data(), length, MPI_UINT64_T, status.MPI_SOURCE,
+                         TAG_WORK, comm, MPI_STATUS_IGNORE);
+                request_outstanding = false;
+
+                absorb_incumbent(unpack_value(message[0]));
+                int count = (int)message[1];
+                if (count > 0) {
+                    message_count--;
+                    black = true;
+                }
+                const uint64_t* record = message.data() + 2;
+                for (int i = 0; i < count; i++) {
+                    pq.push(decode_node(record, items, n, bounds, arena, 0));
+                    record += node_record_words(words);
+                }
+            } else if (status.MPI_TAG == TAG_TOKEN) {
+                long long token[2];
+                MPI_Recv(token, 2, MPI_LONG_LONG, status.MPI_SOURCE,
+                         TAG_TOKEN, comm, MPI_STATUS_IGNORE);
+                have_token = true;
+                token_count = token[0];
+                token_black = token[1] != 0;
+            } else if (status.MPI_TAG == TAG_DONE) {
+                MPI_Recv(nullptr, 0, MPI_BYTE, status.MPI_SOURCE,
+                         TAG_DONE, comm, MPI_STATUS_IGNORE);
+                done = true;
+            }
+        }
+    }
+
+    void send_token(long long count, bool token_color_black) {
+        long long token[2] = {count, token_color_black ? 1 : 0};
+        MPI_Send(token, 2, MPI_LONG_LONG, (rank + 1) % size, TAG_TOKEN, comm);
+    }
+
+    /**
+     * Safra's termination detection, run while this rank is idle. The token
+     * travels the ring 0 -> 1 -> ... -> size-1 -> 0, summing the work
+     * messages each rank sent minus received. Rank 0 declares termination
+     * when the token returns white with a zero sum while rank 0 is idle and
+     * white itself: then every rank is idle and no work is in flight.
+     */
+    void on_idle() {
+        if (rank == 0 && !token_started) {
+            token_started = true;
+            black = false;
+            send_token(0, false);
+            return;
+        }
+        if (!have_token) {
+            return;
+        }
+        have_token = false;
+
+        if (rank == 0) {
+            if (!token_black && !black && token_count + message_count == 0) {
+                for (int other = 1; other < size; other++) {
+                    MPI_Send(nullptr, 0, MPI_BYTE, other, TAG_DONE, comm);
+                }
+                done = true;
             } else {
-                double prev_best = local_best_value;
-                explore_with_pq(root, start_node);
-
-                if (local_best_value <= prev_best) {
-                    // This pattern did not improve the local best; discard its tree
-                    delete root;
-                } else {
-                    // Keep only the tree containing the current best solution
-                    // (any previous best_root can be safely deleted now)
-                    if (best_root && best_root != root) {
-                        delete best_root;
-                    }
-                    best_root = root;
+                black = false;
+                send_token(0, false);
+            }
+        } else {
+            send_token(token_count + message_count, token_black || black);
+            black = false;
+        }
+    }
+
+    // Asks a random other rank for work unless a request is already pending
+    void request_work() {
+        if (request_outstanding) {
+            return;
+        }
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        int victim = (int)(rng % (unsigned int)(size - 1));
+        if (victim >= rank) {
+            victim++;
+        }
+        uint64_t incumbent = pack_value(best_value);
+        MPI_Send(&incumbent, 1, MPI_UINT64_T, victim, TAG_WORK_REQUEST, comm);
+        request_outstanding = true;
+    }
+
+    // Main loop: search locally, serve requests, balance and detect the end
+    void run() {
+        initial_split();
+
+        if (size == 1) {
+            while (!pq.empty()) {
+                expand_next();
+            }
+            return;
+        }
+
+        int since_poll = 0;
+        while (!done) {
+            if (!pq.empty()) {
+                expand_next();
+                if (++since_poll >= POLL_INTERVAL) {
+                    since_poll = 0;
+                    absorb_incumbent(incumbent.fetch());
+                    poll();
                 }
+                continue;
+            }
+
+            absorb_incumbent(incumbent.fetch());
+            request_work();
+            poll();
+            if (pq.empty() && !done) {
+                on_idle();
+                sched_yield();
             }
         }
 
-        // After each pattern, synchronize the best value across ranks so that
-        // later prefixes benefit from better global incumbents and prune more.
-        float synced_best = 0.0f;
-        MPI_Allreduce(&local_best_value, &synced_best, 1, MPI_FLOAT, MPI_MAX, comm);
-        local_best_value = synced_best;
+        // Drain: our last request must be answered, and requests from ranks
+        // that have not seen the end yet need an (empty) answer. Nobody
+        // leaves the barrier before every rank has stopped sending.
+        while (request_outstanding) {
+            poll();
+        }
+        MPI_Request barrier;
+        MPI_Ibarrier(comm, &barrier);
+        int finished = 0;
+        while (!finished) {
+            poll();
+            MPI_Test(&barrier, &finished, MPI_STATUS_IGNORE);
+        }
     }
+};
 
-    // Find global best across all ranks
-    float global_best = 0.0f;
-    MPI_Allreduce(&local_best_value, &global_best, 1, MPI_FLOAT, MPI_MAX, comm);
+} // namespace
 
-    // Gather statistics
-    long long total_nodes_explored = 0;
-    long long total_nodes_pruned = 0;
-    MPI_Allreduce(&local_nodes_explored, &total_nodes_explored, 1, MPI_LONG_LONG, MPI_SUM, comm);
-    MPI_Allreduce(&local_nodes_pruned, &total_nodes_pruned, 1, MPI_LONG_LONG, MPI_SUM, comm);
+/**
+ * Shares the best solution found by any rank with every rank.
+ * A MAXLOC reduction over the ranks' own best values picks the winning
+ * rank, which reads its items off its decision bits and broadcasts them.
+ *
+ * @param own_best_value Value of the best solution this rank found itself
+ * @param decisions Decision bits of that solution
+ * @param items Array of items in the order the search used
+ * @param item_count Total number of items
+ * @param best_items Output (optional): new[]-allocated copy of the solution
+ * @param comm Communicator of the search
+ * @return Number of items in the solution
+ */
+int broadcast_best_solution(float own_best_value,
+                            const uint64_t* decisions,
+                            const Item* items,
+                            int item_count,
+                            Item** best_items,
+                            MPI_Comm comm) {
+    int world_rank = 0;
+    MPI_Comm_rank(comm, &world_rank);
 
     // Find which rank has the global best solution
     struct {
         float value;
         int rank;
-    } local_result = {local_best_value, world_rank}, global_result;
+    } local_result = {own_best_value, world_rank}, global_result;
 
     MPI_Allreduce(&local_result, &global_result, 1, MPI_FLOAT_INT, MPI_MAXLOC, comm);
     int winning_rank = global_result.rank;
 
-    // The winning rank reconstructs and broadcasts the solution
-    std::vector<Item> solution_items;
+    // The winning rank reads its solution off the decision bits and broadcasts it
+    std::vector<Item> solution_items(item_count);
     int solution_count = 0;
 
-    if (world_rank == winning_rank && best_root && best_node) {
-        reconstruct_solution(best_root, best_node, solution_items);
-        solution_count = solution_items.size();
+    if (world_rank == winning_rank) {
+        solution_count = collect_solution(decisions, items, item_count,
+                                          solution_items.data());
     }
 
     // Broadcast solution count and items from winning rank
@@ -292,21 +512,186 @@ auto explore_with_pq = [&](TreeNode* root, TreeNode* start_node) {
         MPI_Bcast(solution_items.data(), solution_count, MPI_ITEM, winning_rank, comm);
 
         MPI_Type_free(&MPI_ITEM);
-    }    // Set output parameters
-    if (global_best_value) {
-        *global_best_value = global_best;
-    }
-    if (best_count) {
-        *best_count = solution_count;
     }
+
     if (best_items) {
         *best_items = new Item[solution_count];
         for (int i = 0; i < solution_count; ++i) {
             (*best_items)[i] = solution_items[i];
         }
     }
+    return solution_count;
+}
+
+/**
+ * Runs reduced-cost variable fixing on rank 0 and broadcasts the result, so
+ * every rank searches the same free items and maps the same solution back.
+ *
+ * @param items Array of items (sorted by ratio in place on rank 0)
+ * @param item_count Number of items
+ * @param capacity Knapsack capacity
+ * @param out Output: the reduced problem, on every rank
+ * @param comm Communicator of the search
+ */
+void fix_variables_shared(Item* items,
+                          int item_count,
+                          float capacity,
+                          ReducedProblem* out,
+                          MPI_Comm comm) {
+    int world_rank = 0;
+    MPI_Comm_rank(comm, &world_rank);
+
+    int counts[3] = {0, 0, 0};
+    float totals[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    if (world_rank == 0) {
+        fix_variables(items, item_count, capacity, out);
+        counts[0] = (int)out->free_items.size();
+        counts[1] = (int)out->fixed_in.size();
+        counts[2] = out->fixed_out;
+        totals[0] = out->capacity;
+        totals[1] = out->fixed_value;
+        totals[2] = out->lower_bound;
+        totals[3] = out->upper_bound;
+    }
+    MPI_Bcast(counts, 3, MPI_INT, 0, comm);
+    MPI_Bcast(totals, 4, MPI_FLOAT, 0, comm);
+
+    out->free_items.resize(counts[0]);
+    out->fixed_in.resize(counts[1]);
+    out->fixed_out = counts[2];
+    out->capacity = totals[0];
+    out->fixed_value = totals[1];
+    out->lower_bound = totals[2];
+    out->upper_bound = totals[3];
+
+    // Items are plain structs and every rank runs the same binary
+    MPI_Bcast(out->free_items.data(), counts[0] * (int)sizeof(Item), MPI_BYTE, 0, comm);
+    MPI_Bcast(out->fixed_in.data(), counts[1] * (int)sizeof(Item), MPI_BYTE, 0, comm);
+}
+
+namespace {
+
+// Distributed search over all items given (see branch_and_bound_mpi)
+void search_mpi(Item* items,
+                int item_count,
+                float capacity,
+                float* global_best_value,
+                Item** best_items,
+                int* best_count,
+                MpiStats* stats,
+                MPI_Comm comm) {
+    int world_rank = 0;
+    int world_size = 1;
+    MPI_Comm_rank(comm, &world_rank);
+    MPI_Comm_size(comm, &world_size);
+
+    if (item_count == 0) {
+        if (global_best_value) *global_best_value = 0.0f;
+        if (best_items) *best_items = nullptr;
+        if (best_count) *best_count = 0;
+        if (stats) {
+            stats->nodes_explored = 0;
+            stats->nodes_pruned = 0;
+        }
+        return;
+    }
+
+    // Sort items
+    sort_items(items, item_count);
+    if (world_rank == 0) {
+        print_sorted_items(items, item_count);
+    }
+
+    // Prefix sums over the sorted items make each bound O(log n)
+    PrefixBound bounds(items, item_count, capacity);
+
+    IncumbentWindow incumbent(comm);
+    RankSearch search(items, item_count, capacity, bounds, incumbent, comm);
+
+    // Every rank runs the primal heuristic from its own start (rank 0 from
+    // the plain greedy); the best value is every rank's initial incumbent
+    HeuristicSolution seed;
+    primal_heuristic(items, item_count, capacity, (unsigned int)world_rank, &seed);
+    search.seed_incumbent(seed);
+    float seeded = 0.0f;
+    MPI_Allreduce(&seed.value, &seeded, 1, MPI_FLOAT, MPI_MAX, comm);
+    search.absorb_incumbent(seeded);
+    if (world_rank == 0) {
+        print_info("Primal heuristic (best of %d starts): %.2f\n", world_size, seeded);
+    }
+
+    search.run();
+
+    // Find global best across all ranks
+    float global_best = 0.0f;
+    MPI_Allreduce(&search.best_value, &global_best, 1, MPI_FLOAT, MPI_MAX, comm);
+
+    // Gather statistics
+    long long total_nodes_explored = 0;
+    long long total_nodes_pruned = 0;
+    MPI_Allreduce(&search.nodes_explored, &total_nodes_explored, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    MPI_Allreduce(&search.nodes_pruned, &total_nodes_pruned, 1, MPI_LONG_LONG, MPI_SUM, comm);
+
+    int solution_count = broadcast_best_solution(search.own_best_value,
+                                                 search.best_decisions.data(),
+                                                 items, item_count, best_items, comm);
+
+    // Set output parameters
+    if (global_best_value) {
+        *global_best_value = global_best;
+    }
+    if (best_count) {
+        *best_count = solution_count;
+    }
     if (stats) {
         stats->nodes_explored = (int)total_nodes_explored;
         stats->nodes_pruned = (int)total_nodes_pruned;
     }
 }
+
+} // namespace
+
+/**
+ * Distributed branch and bound over the items left free by reduced-cost
+ * variable fixing (or all items if set_variable_fixing(false) was called).
+ * Fixing runs on rank 0 and the reduced problem is broadcast; every rank
+ * returns the solution of the full problem.
+ *
+ * @param items Array of available items
+ * @param item_count Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param global_best_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param stats Output: node statistics summed over all ranks
+ * @param comm Communicator of the participating ranks
+ */
+void branch_and_bound_mpi(Item* items,
+                          int item_count,
+                          float capacity,
+                          float* global_best_value,
+                          Item** best_items,
+                          int* best_count,
+                          MpiStats* stats,
+                          MPI_Comm comm) {
+    if (!variable_fixing()) {
+        search_mpi(items, item_count, capacity, global_best_value,
+                   best_items, best_count, stats, comm);
+        return;
+    }
+
+    // Nothing is searched if every item is fixed
+    if (stats) {
+        stats->nodes_explored = 0;
+        stats->nodes_pruned = 0;
+    }
+
+    ReducedProblem reduced;
+    fix_variables_shared(items, item_count, capacity, &reduced, comm);
+    solve_reduced(&reduced, item_count, global_best_value, best_items, best_count,
+                  [&](Item* free_items, int free_count, float free_capacity,
+                      float* value, Item** chosen, int* chosen_count) {
+                      search_mpi(free_items, free_count, free_capacity, value,
+                                 chosen, chosen_count, stats, comm);
+                  });
+}
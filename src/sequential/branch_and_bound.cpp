@@ -1,68 +1,12 @@
+#include <stdio.h>
 #include <queue>
 #include <algorithm>
 #include <vector>
-#include <functional>
 #include "branch_and_bound.h"
 #include "knapsack_utils.h"
+#include "dominance_table.h"
 #include "output_display.h"
-
-/**
- * Reconstructs the optimal solution by traversing the search tree.
- * Performs depth-first search from root to find the path leading to best_node,
- * collecting all items that were included along the path.
- * 
- * @param root Root of the search tree
- * @param best_node Node containing the optimal solution
- * @param best_items Output array to store selected items
- * @param best_count Output count of selected items
- */
-void reconstruct_solution(TreeNode* root, TreeNode* best_node, 
-                         Item** best_items, int* best_count) {
-    std::vector<Item> solution_items;
-    std::function<bool(TreeNode*, float, float, std::vector<Item>&)> find_path;
-    
-    // Recursive lambda to find path from root to target node
-    // Matches nodes by their accumulated value and weight
-    find_path = [&](TreeNode* node, float target_value, float target_weight, 
-                     std::vector<Item>& path) -> bool {
-        if (!node) return false;
-        
-        // Found the target node
-        if (node->t_value == target_value && node->t_weight == target_weight) {
-            return true;
-        }
-        
-        // Explore left subtree (item inclusion branch)
-        if (node->left) {
-            if (node->left->included) {
-                path.push_back(node->left->item);
-            }
-            if (find_path(node->left, target_value, target_weight, path)) {
-                return true;
-            }
-            // Backtrack if path not found
-            if (node->left->included) {
-                path.pop_back();
-            }
-        }
-        
-        // Explore right subtree (item exclusion branch)
-        if (node->right) {
-            if (find_path(node->right, target_value, target_weight, path)) {
-                return true;
-            }
-        }
-        
-        return false;
-    };
-    
-    find_path(root, best_node->t_value, best_node->t_weight, solution_items);
-    
-    *best_count = solution_items.size();
-    for (int i = 0; i < *best_count; i++) {
-        (*best_items)[i] = solution_items[i];
-    }
-}
+#include "primal_heuristic.h"
 
 /**
  * Branch and Bound algorithm for 0/1 Knapsack Problem.
@@ -78,103 +22,206 @@ void reconstruct_solution(TreeNode* root, TreeNode* best_node,
  * 5. Prune branches with bound <= current best
  * 6. Continue until priority queue is empty
  * 
+ * Each node stores its decision path as a bitset, so the item set of the
+ * best node is recovered directly and the search keeps only the open
+ * frontier alive rather than the whole tree.
+ *
+ * With a frontier memory budget (options->frontier_budget_bytes) the queue
+ * never grows past the budget: once it is full, the best open node is
+ * searched depth-first to completion with an O(n) stack instead of being
+ * expanded into the queue. The search stays best-first at the top of the
+ * tree, where ordering matters most, and peak memory stays bounded.
+ *
+ * Children dominated by an earlier node at the same level (no heavier, at
+ * least as valuable) are dropped before they are pushed; see
+ * dominance_table.h. options->dominance_table_bytes sizes the table.
+ *
+ * The upper bound is the Bound policy (see bound_policy.h), fixed at
+ * compile time so it is inlined into the loop.
+ * 
  * @param items Array of available items
  * @param n Number of items
  * @param capacity Maximum knapsack capacity
  * @param max_value Output: optimal value achieved
  * @param best_items Output: array of selected items
  * @param best_count Output: number of selected items
- * @return Root of the search tree (for solution reconstruction)
+ * @param nodes_explored_out Optional output: number of nodes visited
+ * @param nodes_pruned_out Optional output: number of nodes pruned
+ * @param options Optional search settings (nullptr for defaults)
  */
-TreeNode* branch_and_bound(Item* items, int n, float capacity, float* max_value, 
-                          Item** best_items, int* best_count,
-                          int* nodes_explored_out, int* nodes_pruned_out) {
+template <class Bound>
+void branch_and_bound_with(Item* items, int n, float capacity, float* max_value,
+                           Item** best_items, int* best_count,
+                           int* nodes_explored_out, int* nodes_pruned_out,
+                           const SearchOptions* options) {
     // Sort items by value/weight ratio (descending)
     // This improves bound quality and pruning effectiveness
-    std::sort(items, items + n, compare_items);
+    sort_items(items, n);
     print_sorted_items(items, n);
+
+    // Upper bound policy over the sorted items
+    Bound bounds(items, n, capacity);
     
     // Max-heap priority queue: nodes with higher bounds explored first
     std::priority_queue<TreeNode*, std::vector<TreeNode*>, CompareNode> pq;
-    
+
+    // All nodes of this search come from one arena. Nodes carry their own
+    // decision bits, so each is recycled as soon as it is pruned or expanded
+    const int words = TreeNode::decision_words(n);
+    NodeArena arena(1, TreeNode::bytes_for(n));
+
+    // States of pushed nodes; a child dominated by one is never pushed
+    SearchOptions defaults;
+    DominanceTable dominance(capacity, (options ? options : &defaults)->dominance_table_bytes);
+
+    // Frontier size the memory budget allows (0 = unlimited). Each open
+    // node costs its arena block plus a queue slot
+    size_t frontier_limit = 0;
+    if (options && options->frontier_budget_bytes > 0) {
+        size_t node_cost = TreeNode::bytes_for(n) + sizeof(TreeNode*);
+        frontier_limit = std::max<size_t>(1, options->frontier_budget_bytes / node_cost);
+        print_info("Frontier budget: %zu nodes\n", frontier_limit);
+    }
+
     // Initialize root node representing empty knapsack
-    TreeNode* root = new TreeNode();
-    root->level = -1;
-    root->t_value = 0.0f;
-    root->t_weight = 0.0f;
-    root->bound = calculate_bound(root, items, n, capacity);
-    
+    TreeNode* root = TreeNode::create_root(arena, 0, words);
+    root->bound = bounds.bound(root);
+
     pq.push(root);
-    
-    *max_value = 0.0f;
-    TreeNode* best_node = root;
-    
+
+    // Seed the incumbent with the primal heuristic, so nodes can be pruned
+    // from the first expansion on
+    HeuristicSolution seed;
+    primal_heuristic(items, n, capacity, 0, &seed);
+    print_info("Primal heuristic: %.2f\n", seed.value);
+    *max_value = seed.value;
+    // Decision bits of the incumbent solution
+    std::vector<uint64_t> best_decisions = seed.decisions;
+
     int nodes_explored = 0;
     int nodes_pruned = 0;
-    
-    // Main branch and bound loop
-    while (!pq.empty()) {
-        // Extract node with highest bound (best-first search)
-        TreeNode* current = pq.top();
-        pq.pop();
-        
+
+    // Expands one node: prunes it or writes its promising children to
+    // `children` (exclude branch first), updating the incumbent on the way.
+    // The node itself is recycled; returns the number of children
+    auto expand = [&](TreeNode* current, TreeNode** children) -> int {
         nodes_explored++;
-        
+
         // Pruning condition: if this node's bound cannot beat current best, skip it
-        if (current->bound <= *max_value) {
+        if (!bounds.can_improve(current->bound, *max_value)) {
             nodes_pruned++;
-            continue;
+            arena.recycle(current);
+            return 0;
         }
-        
+
         // Leaf node: all items have been considered
         if (current->level == n - 1) {
-            continue;
+            arena.recycle(current);
+            return 0;
         }
-        
+
         int next_level = current->level + 1;
-        
+        TreeNode* left_child = nullptr;
+
         // Generate left child: include next item (only if capacity allows)
         if (current->t_weight + items[next_level].weight <= capacity) {
-            TreeNode* left_child = current->add(
+            left_child = current->add(
+                arena, 0, words,
                 true,
-                items[next_level],
                 current->t_weight + items[next_level].weight,
-                current->t_value + items[next_level].value,
-                next_level
+                current->t_value + items[next_level].value
             );
-            
-            left_child->bound = calculate_bound(left_child, items, n, capacity);
-            
+
+            left_child->bound = bounds.bound(left_child);
+
             // Update incumbent solution if this path is better
             if (left_child->t_value > *max_value) {
                 *max_value = left_child->t_value;
-                best_node = left_child;
-            }
-            
-            // Add to queue only if bound is promising
-            if (left_child->bound > *max_value) {
-                pq.push(left_child);
+                std::copy(left_child->decisions(), left_child->decisions() + words,
+                          best_decisions.begin());
             }
         }
-        
+
         // Generate right child: exclude next item (always feasible)
         TreeNode* right_child = current->add(
+            arena, 0, words,
             false,
-            items[next_level],
             current->t_weight,
-            current->t_value,
-            next_level
+            current->t_value
         );
-        
-        right_child->bound = calculate_bound(right_child, items, n, capacity);
-        
-        // Add to queue only if bound is promising
-        if (right_child->bound > *max_value) {
-            pq.push(right_child);
+
+        right_child->bound = bounds.bound(right_child);
+
+        // Keep children only if their bound is promising
+        int count = 0;
+        if (bounds.can_improve(right_child->bound, *max_value) &&
+            dominance.admit(right_child)) {
+            children[count++] = right_child;
+        } else {
+            arena.recycle(right_child);
+        }
+        if (left_child) {
+            if (bounds.can_improve(left_child->bound, *max_value) &&
+                dominance.admit(left_child)) {
+                children[count++] = left_child;
+            } else {
+                arena.recycle(left_child);
+            }
+        }
+
+        // Both children hold their own copy of the path; parent is done
+        arena.recycle(current);
+        return count;
+    };
+
+    // Depth-first search of the subtree under start, include branch first.
+    // At most one pending sibling per level, so the stack stays O(n)
+    std::vector<TreeNode*> dive_stack;
+    int dives = 0;
+    auto dive = [&](TreeNode* start) {
+        dives++;
+        dive_stack.push_back(start);
+        TreeNode* children[2];
+        while (!dive_stack.empty()) {
+            TreeNode* current = dive_stack.back();
+            dive_stack.pop_back();
+            int count = expand(current, children);
+            for (int i = 0; i < count; i++) {
+                dive_stack.push_back(children[i]);
+            }
+        }
+    };
+
+    // Main branch and bound loop
+    TreeNode* children[2];
+    size_t peak_frontier = 0;
+    while (!pq.empty()) {
+        peak_frontier = std::max(peak_frontier, pq.size());
+
+        // Extract node with highest bound (best-first search)
+        TreeNode* current = pq.top();
+        pq.pop();
+
+        // Frontier full: finish the best node depth-first instead of
+        // adding its children to the queue
+        if (frontier_limit && pq.size() + 2 > frontier_limit) {
+            dive(current);
+            continue;
+        }
+
+        int count = expand(current, children);
+        for (int i = 0; i < count; i++) {
+            pq.push(children[i]);
         }
     }
-    
+
+    if (frontier_limit) {
+        print_info("Peak frontier: %zu nodes, depth-first dives: %d\n", peak_frontier, dives);
+    }
+
     print_statistics(nodes_explored, nodes_pruned);
+    bounds.report();
+    dominance.report();
     if (nodes_explored_out) {
         *nodes_explored_out = nodes_explored;
     }
@@ -182,10 +229,27 @@ TreeNode* branch_and_bound(Item* items, int n, float capacity, float* max_value,
         *nodes_pruned_out = nodes_pruned;
     }
     
-    // Reconstruct the solution by tracing path from root to best_node
+    // Read the solution straight off the incumbent's decision bits
     *best_items = new Item[n];
-    *best_count = 0;
-    reconstruct_solution(root, best_node, best_items, best_count);
-    
-    return root;
+    *best_count = collect_solution(best_decisions.data(), items, n, *best_items);
+}
+
+template void branch_and_bound_with<DantzigBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
+template void branch_and_bound_with<MartelloTothBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
+template void branch_and_bound_with<MullerMerbachBound>(
+    Item*, int, float, float*, Item**, int*, int*, int*, const SearchOptions*);
+
+/**
+ * Branch and bound with the Dantzig (fractional) bound.
+ */
+void branch_and_bound(Item* items, int n, float capacity, float* max_value,
+                      Item** best_items, int* best_count,
+                      int* nodes_explored_out, int* nodes_pruned_out,
+                      const SearchOptions* options) {
+    branch_and_bound_with<DantzigBound>(items, n, capacity, max_value,
+                                        best_items, best_count,
+                                        nodes_explored_out, nodes_pruned_out,
+                                        options);
 }
@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include "branch_and_bound.h"
+#include "dominance_table.h"
+#include "dynamic_programming.h"
+#include "knapsack_utils.h"
+#include "output_display.h"
+#include "primal_heuristic.h"
+
+namespace {
+
+// Largest integer up to which every integer is exactly a float
+const int64_t FLOAT_EXACT_MAX = (int64_t)1 << 24;
+
+/**
+ * Search node of the fixed-point search: the same layout as TreeNode (the
+ * packed decision bits follow the node in its arena block) with exact
+ * integer totals and bound.
+ */
+struct FixedNode {
+    int64_t t_weight;   // Scaled weight of items selected so far
+    int64_t t_value;    // Scaled value of items selected so far
+    int64_t bound;      // Floored fractional bound
+    int level;          // Last decided item index
+
+    static size_t bytes_for(int n) {
+        return sizeof(FixedNode) + TreeNode::decision_words(n) * sizeof(uint64_t);
+    }
+
+    uint64_t* decisions() {
+        return reinterpret_cast<uint64_t*>(this + 1);
+    }
+};
+
+struct CompareFixedNode {
+    bool operator()(const FixedNode* a, const FixedNode* b) const {
+        return a->bound < b->bound;
+    }
+};
+
+/**
+ * Fractional (Dantzig) bound in scaled integers over prefix sums of the
+ * sorted items. Values are integers, so no solution can be worth the
+ * fractional part of the bound and it is rounded down.
+ */
+class FixedBound {
+public:
+    FixedBound(const ScaledInstance& instance)
+        : instance_(instance),
+          n_((int)instance.weight.size()),
+          prefix_weight_(n_ + 1, 0),
+          prefix_value_(n_ + 1, 0) {
+        for (int j = 0; j < n_; j++) {
+            prefix_weight_[j + 1] = prefix_weight_[j] + instance.weight[j];
+            prefix_value_[j + 1] = prefix_value_[j] + instance.value[j];
+        }
+    }
+
+    int64_t bound(int level, int64_t t_weight, int64_t t_value) const {
+        const int first = level + 1;
+        const int64_t target = prefix_weight_[first] + instance_.capacity - t_weight;
+        // Last k with prefix_weight_[k] <= target: items [first, k) fit whole
+        int k = (int)(std::upper_bound(prefix_weight_.begin() + first,
+                                       prefix_weight_.end(), target)
+                      - prefix_weight_.begin()) - 1;
+        int64_t value = t_value + prefix_value_[k] - prefix_value_[first];
+        if (k < n_) {
+            // residual < weight[k], so the product stays below 2^62
+            int64_t residual = target - prefix_weight_[k];
+            value += residual * instance_.value[k] / instance_.weight[k];
+        }
+        return value;
+    }
+
+private:
+    const ScaledInstance& instance_;
+    int n_;
+    std::vector<int64_t> prefix_weight_;
+    std::vector<int64_t> prefix_value_;
+};
+
+} // namespace
+
+/**
+ * Branch and bound in fixed-point arithmetic.
+ *
+ * Weights, values and capacity are scaled to exact integers (the powers of
+ * ten the DP engine uses, see scale_instance), and the search runs on
+ * int64_t totals and bounds. This gives:
+ *  - exact pruning: bound <= incumbent needs no float tolerance, and a
+ *    node is never kept or dropped because of rounding
+ *  - floored bounds: values are integers, so the fractional bound rounds
+ *    down, which prunes every node whose bound only beats the incumbent
+ *    by a fraction of a value unit
+ *  - an exact ratio order, compared by cross-multiplication
+ *
+ * Otherwise the search is branch_and_bound: best-first from a primal
+ * heuristic incumbent, decision bits carried in each node, the same
+ * depth-first fallback when a frontier budget is set, and the same
+ * dominance table (see dominance_table.h), fed the scaled totals. The table
+ * stores floats, so it is only used while every scaled total is an exact
+ * float (at most 2^24); larger instances search without it. Instances
+ * whose numbers do not scale to integers are handed to branch_and_bound.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param options Optional search settings (nullptr for defaults)
+ */
+void branch_and_bound_fixed(Item* items, int n, float capacity, float* max_value,
+                            Item** best_items, int* best_count,
+                            int* nodes_explored_out, int* nodes_pruned_out,
+                            const SearchOptions* options) {
+    ScaledInstance scaled;
+    if (!scale_instance(items, n, capacity, &scaled)) {
+        print_info("Fixed-point mode not applicable (numbers not integral at up to 6 "
+                   "decimals); using branch and bound\n");
+        branch_and_bound(items, n, capacity, max_value, best_items, best_count,
+                         nodes_explored_out, nodes_pruned_out, options);
+        return;
+    }
+    print_info("Fixed point: weight scale %lld, value scale %lld\n",
+               (long long)scaled.scale, (long long)scaled.value_scale);
+
+    // Exact ratio order: v_a / w_a > v_b / w_b  <=>  v_a * w_b > v_b * w_a,
+    // ties broken by value as in compare_items
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        int64_t lhs = (int64_t)scaled.value[a] * scaled.weight[b];
+        int64_t rhs = (int64_t)scaled.value[b] * scaled.weight[a];
+        if (lhs != rhs) {
+            return lhs > rhs;
+        }
+        return scaled.value[a] > scaled.value[b];
+    });
+    std::vector<Item> original(items, items + n);
+    ScaledInstance sorted = scaled;
+    for (int i = 0; i < n; i++) {
+        items[i] = original[order[i]];
+        sorted.weight[i] = scaled.weight[order[i]];
+        sorted.value[i] = scaled.value[order[i]];
+    }
+    print_sorted_items(items, n);
+
+    FixedBound bounds(sorted);
+    const int64_t cap = sorted.capacity;
+    const int words = TreeNode::decision_words(n);
+    NodeArena arena(1, FixedNode::bytes_for(n));
+
+    // States of pushed nodes in scaled units; a child dominated by one is
+    // never pushed
+    int64_t total_value = 0;
+    for (int i = 0; i < n; i++) {
+        total_value += sorted.value[i];
+    }
+    SearchOptions defaults;
+    size_t table_bytes = (options ? options : &defaults)->dominance_table_bytes;
+    if (cap > FLOAT_EXACT_MAX || total_value > FLOAT_EXACT_MAX) {
+        if (table_bytes > 0) {
+            print_info("Scaled totals exceed 2^24; searching without the dominance table\n");
+        }
+        table_bytes = 0;
+    }
+    DominanceTable dominance((float)cap, table_bytes);
+
+    size_t frontier_limit = 0;
+    if (options && options->frontier_budget_bytes > 0) {
+        size_t node_cost = FixedNode::bytes_for(n) + sizeof(FixedNode*);
+        frontier_limit = std::max<size_t>(1, options->frontier_budget_bytes / node_cost);
+        print_info("Frontier budget: %zu nodes\n", frontier_limit);
+    }
+
+    // Incumbent from the primal heuristic, re-summed exactly
+    HeuristicSolution seed;
+    primal_heuristic(items, n, capacity, 0, &seed);
+    int64_t seed_weight = 0;
+    int64_t best_value = 0;
+    for (int i = 0; i < n; i++) {
+        if ((seed.decisions[i / 64] >> (i % 64)) & 1) {
+            seed_weight += sorted.weight[i];
+            best_value += sorted.value[i];
+        }
+    }
+    std::vector<uint64_t> best_decisions(words, 0);
+    if (seed_weight <= cap) {
+        best_decisions = seed.decisions;
+    } else {
+        best_value = 0;
+    }
+    print_info("Primal heuristic: %.2f\n", (double)best_value / sorted.value_scale);
+
+    FixedNode* root = new (arena.allocate()) FixedNode();
+    root->t_weight = 0;
+    root->t_value = 0;
+    root->level = -1;
+    memset(root->decisions(), 0, words * sizeof(uint64_t));
+    root->bound = n > 0 ? bounds.bound(-1, 0, 0) : 0;
+
+    std::priority_queue<FixedNode*, std::vector<FixedNode*>, CompareFixedNode> pq;
+    pq.push(root);
+
+    int nodes_explored = 0;
+    int nodes_pruned = 0;
+
+    // Child deciding item level + 1, with its bits copied from the parent
+    auto make_child = [&](FixedNode* parent, bool include) -> FixedNode* {
+        FixedNode* node = new (arena.allocate()) FixedNode();
+        node->level = parent->level + 1;
+        node->t_weight = parent->t_weight + (include ? sorted.weight[node->level] : 0);
+        node->t_value = parent->t_value + (include ? sorted.value[node->level] : 0);
+        memcpy(node->decisions(), parent->decisions(), words * sizeof(uint64_t));
+        if (include) {
+            node->decisions()[node->level >> 6] |= uint64_t(1) << (node->level & 63);
+        }
+        node->bound = bounds.bound(node->level, node->t_weight, node->t_value);
+        return node;
+    };
+
+    // Dominance check of a child about to be pushed; its totals are exact
+    // floats whenever the table is enabled
+    auto admit = [&](const FixedNode* node) -> bool {
+        return dominance.admit(node->level, (float)node->t_weight, (float)node->t_value);
+    };
+
+    // Prunes or expands one node (exclude child first, as branch_and_bound)
+    auto expand = [&](FixedNode* current, FixedNode** children) -> int {
+        nodes_explored++;
+        if (current->bound <= best_value) {
+            nodes_pruned++;
+            arena.recycle(current);
+            return 0;
+        }
+        if (current->level == n - 1) {
+            arena.recycle(current);
+            return 0;
+        }
+
+        int next_level = current->level + 1;
+        FixedNode* left_child = nullptr;
+        if (current->t_weight + sorted.weight[next_level] <= cap) {
+            left_child = make_child(current, true);
+            if (left_child->t_value > best_value) {
+                best_value = left_child->t_value;
+                std::copy(left_child->decisions(), left_child->decisions() + words,
+                          best_decisions.begin());
+            }
+        }
+        FixedNode* right_child = make_child(current, false);
+
+        int count = 0;
+        if (right_child->bound > best_value && admit(right_child)) {
+            children[count++] = right_child;
+        } else {
+            arena.recycle(right_child);
+        }
+        if (left_child) {
+            if (left_child->bound > best_value && admit(left_child)) {
+                children[count++] = left_child;
+            } else {
+                arena.recycle(left_child);
+            }
+        }
+        arena.recycle(current);
+        return count;
+    };
+
+    std::vector<FixedNode*> dive_stack;
+    FixedNode* children[2];
+    while (!pq.empty()) {
+        FixedNode* current = pq.top();
+        pq.pop();
+
+        // Frontier full: finish the best node depth-first
+        if (frontier_limit && pq.size() + 2 > frontier_limit) {
+            dive_stack.push_back(current);
+            while (!dive_stack.empty()) {
+                FixedNode* node = dive_stack.back();
+                dive_stack.pop_back();
+                int count = expand(node, children);
+                for (int i = 0; i < count; i++) {
+                    dive_stack.push_back(children[i]);
+                }
+            }
+            continue;
+        }
+
+        int count = expand(current, children);
+        for (int i = 0; i < count; i++) {
+            pq.push(children[i]);
+        }
+    }
+
+    print_statistics(nodes_explored, nodes_pruned);
+    dominance.report();
+    if (nodes_explored_out) {
+        *nodes_explored_out = nodes_explored;
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = nodes_pruned;
+    }
+
+    *best_items = new Item[n];
+    *best_count = collect_solution(best_decisions.data(), items, n, *best_items);
+    *max_value = 0.0f;
+    for (int i = 0; i < *best_count; i++) {
+        *max_value += (*best_items)[i].value;
+    }
+}
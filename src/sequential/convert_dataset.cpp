@@ -0,0 +1,97 @@
+/**
+ * Dataset Converter for 0/1 Knapsack Problem
+ * Converts instances between the text format and the binary format the
+ * solvers memory-map (see include/common/parser/instance_file.h)
+ *
+ * Usage: ./convert_dataset <input_file> <output_file>
+ *
+ * A text input is written as a binary instance; a binary input is written
+ * back as text, so a converted file can be inspected or diffed.
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -Iinclude/common src/sequential/convert_dataset.cpp \
+ *       src/common/parser/parser.cpp src/common/parser/instance_file.cpp \
+ *       -o convert_dataset
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "parser/parser.h"
+#include "parser/instance_file.h"
+
+// Writes x with the fewest decimals (at least two) that read back as x
+void print_number(FILE* file, float x) {
+    char text[64];
+    for (int digits = 2; digits <= 9; digits++) {
+        snprintf(text, sizeof(text), "%.*f", digits, x);
+        if (strtof(text, nullptr) == x) {
+            break;
+        }
+    }
+    fputs(text, file);
+}
+
+bool write_text(const char* filename, const Item* items, int n, float capacity) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Error: Could not create output file %s\n", filename);
+        return false;
+    }
+    fprintf(file, "%d\n", n);
+    for (int i = 0; i < n; i++) {
+        fprintf(file, "%d ", items[i].id);
+        print_number(file, items[i].value);
+        fputc(' ', file);
+        print_number(file, items[i].weight);
+        fputc('\n', file);
+    }
+    print_number(file, capacity);
+    fputc('\n', file);
+    return fclose(file) == 0;
+}
+
+bool write_binary(const char* filename, const Item* items, int n, float capacity) {
+    std::vector<float> weight(n);
+    std::vector<float> value(n);
+    std::vector<int32_t> id(n);
+    for (int i = 0; i < n; i++) {
+        weight[i] = items[i].weight;
+        value[i] = items[i].value;
+        id[i] = items[i].id;
+    }
+    return write_instance_file(filename, weight.data(), value.data(), id.data(), n, capacity);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage: %s <input_file> <output_file>\n", argv[0]);
+        printf("\nText input is written as a binary instance, binary input as text.\n");
+        printf("\nExample: %s data/121.txt data/121.bin\n", argv[0]);
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    bool to_binary = !is_instance_file(input_file);
+
+    int n = 0;
+    float capacity = 0.0f;
+    Item* items = read_items(input_file, &n, &capacity);
+    if (!items) {
+        fprintf(stderr, "Error: Failed to load items from file %s\n", input_file);
+        return 1;
+    }
+
+    bool ok = to_binary ? write_binary(output_file, items, n, capacity)
+                        : write_text(output_file, items, n, capacity);
+    delete[] items;
+    if (!ok) {
+        return 1;
+    }
+
+    printf("Converted %s -> %s\n", input_file, output_file);
+    printf("  Items: %d\n", n);
+    printf("  Format: %s\n", to_binary ? "binary" : "text");
+    return 0;
+}
@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "dynamic_programming.h"
+#include "branch_and_bound.h"
+#include "output_display.h"
+
+namespace {
+
+// Capacity cells per work block of a DP pass (64 KiB of int32)
+const int64_t DP_BLOCK = 16384;
+
+// Passes over fewer cells than this stay on one thread
+const int64_t DP_PARALLEL_MIN = 4 * DP_BLOCK;
+
+// Largest power of ten tried when scaling to integers
+const int MAX_SCALE_DIGITS = 6;
+
+// Rounding error a float carries into x = value * scale
+inline double float_tolerance(double x) {
+    return 1e-9 + fabs(x) * FLT_EPSILON;
+}
+
+/**
+ * Finds the smallest power of ten that turns every value into an integer
+ * (within float rounding). Returns 0 if none up to 10^MAX_SCALE_DIGITS does.
+ */
+int64_t integral_scale(const float* values, int count, int stride) {
+    int64_t scale = 1;
+    for (int digits = 0; digits <= MAX_SCALE_DIGITS; digits++, scale *= 10) {
+        bool integral = true;
+        for (int i = 0; i < count && integral; i++) {
+            double x = (double)values[i * stride] * (double)scale;
+            integral = fabs(x - floor(x + 0.5)) <= float_tolerance(x);
+        }
+        if (integral) {
+            return scale;
+        }
+    }
+    return 0;
+}
+
+// out[i] = max(keep[i], skip[i] + value), the inner DP update
+typedef void (*MaxKernel)(const int32_t* skip, const int32_t* keep,
+                          int32_t* out, int64_t count, int32_t value);
+
+void max_kernel_scalar(const int32_t* skip, const int32_t* keep,
+                       int32_t* out, int64_t count, int32_t value) {
+    for (int64_t i = 0; i < count; i++) {
+        int32_t take = skip[i] + value;
+        out[i] = take > keep[i] ? take : keep[i];
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// AVX2: eight cells per instruction, selected at run time
+__attribute__((target("avx2")))
+void max_kernel_avx2(const int32_t* skip, const int32_t* keep,
+                     int32_t* out, int64_t count, int32_t value) {
+    __m256i add = _mm256_set1_epi32(value);
+    int64_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i take = _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i*)(skip + i)), add);
+        __m256i old = _mm256_loadu_si256((const __m256i*)(keep + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_max_epi32(take, old));
+    }
+    max_kernel_scalar(skip + i, keep + i, out + i, count - i, value);
+}
+#endif
+
+#if defined(__ARM_NEON)
+// NEON: four cells per instruction (always available on AArch64)
+void max_kernel_neon(const int32_t* skip, const int32_t* keep,
+                     int32_t* out, int64_t count, int32_t value) {
+    int32x4_t add = vdupq_n_s32(value);
+    int64_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32x4_t take = vaddq_s32(vld1q_s32(skip + i), add);
+        vst1q_s32(out + i, vmaxq_s32(take, vld1q_s32(keep + i)));
+    }
+    max_kernel_scalar(skip + i, keep + i, out + i, count - i, value);
+}
+#endif
+
+MaxKernel select_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2")) {
+        return max_kernel_avx2;
+    }
+#endif
+#if defined(__ARM_NEON)
+    return max_kernel_neon;
+#endif
+    return max_kernel_scalar;
+}
+
+// Bytes of the four rows of capacity + 1 cells the DP allocates
+double rows_bytes(int64_t capacity) {
+    return 4.0 * (double)(capacity + 1) * sizeof(int32_t);
+}
+
+/**
+ * Dense 0/1 knapsack DP over a range of items with a rolling 1-D array.
+ *
+ * Keeps two rows of capacity + 1 cells: row[c] is the best value of the
+ * items seen so far with total weight <= c. Each item produces the next
+ * row from the previous one, so the update vectorizes without the
+ * in-place aliasing of the classic backwards loop. Rows are split into
+ * DP_BLOCK-cell blocks handed out to the OpenMP team in contiguous runs.
+ */
+class DenseDP {
+public:
+    DenseDP(const ScaledInstance& instance, int num_threads)
+        : instance_(instance),
+          num_threads_(num_threads),
+          kernel_(select_kernel()) {}
+
+    /**
+     * Best value per capacity for items [lo, hi).
+     *
+     * @param a, b Scratch rows of at least capacity + 1 cells
+     * @return a or b, whichever holds the final row
+     */
+    int32_t* forward(int lo, int hi, int64_t capacity, int32_t* a, int32_t* b) const {
+        memset(a, 0, (capacity + 1) * sizeof(int32_t));
+        int64_t cells = capacity + 1;
+        int64_t blocks = (cells + DP_BLOCK - 1) / DP_BLOCK;
+        bool parallel = num_threads_ > 1 && cells >= DP_PARALLEL_MIN;
+        int32_t* result = a;
+
+        #pragma omp parallel num_threads(num_threads_) if(parallel)
+        {
+            int32_t* prev = a;
+            int32_t* next = b;
+            for (int i = lo; i < hi; i++) {
+                int64_t w = instance_.weight[i];
+                if (w > capacity) {
+                    continue;  // Never fits: the row is unchanged
+                }
+                int32_t v = instance_.value[i];
+
+                #pragma omp for schedule(static)
+                for (int64_t block = 0; block < blocks; block++) {
+                    int64_t begin = block * DP_BLOCK;
+                    int64_t end = std::min(begin + DP_BLOCK, cells);
+                    // Cells below w cannot take the item
+                    int64_t split = std::min(std::max(begin, w), end);
+                    if (split > begin) {
+                        memcpy(next + begin, prev + begin, (split - begin) * sizeof(int32_t));
+                    }
+                    if (end > split) {
+                        kernel_(prev + split - w, prev + split, next + split, end - split, v);
+                    }
+                }
+                std::swap(prev, next);
+            }
+            #pragma omp single
+            result = prev;
+        }
+        return result;
+    }
+
+    /**
+     * Recovers the chosen items of [lo, hi) for the given capacity without
+     * an items x capacity table (Hirschberg-style divide and conquer).
+     * The range is halved; a forward pass over each half gives the best
+     * value per capacity, the best split of the capacity between the
+     * halves is read off the two rows, and each half recurses on its share.
+     * Every level costs at most one pass over all items, so recovery adds
+     * about twice the work of the value pass and needs four rows of memory.
+     *
+     * @return Best value of the range (scaled)
+     */
+    int64_t recover(int lo, int hi, int64_t capacity, int32_t** rows,
+                    std::vector<char>& take) const {
+        if (hi - lo == 1) {
+            bool fits = instance_.weight[lo] <= capacity && instance_.value[lo] > 0;
+            take[lo] = fits;
+            return fits ? instance_.value[lo] : 0;
+        }
+
+        int mid = lo + (hi - lo) / 2;
+        const int32_t* left = forward(lo, mid, capacity, rows[0], rows[1]);
+        const int32_t* right = forward(mid, hi, capacity, rows[2], rows[3]);
+
+        int64_t best_split = 0;
+        int64_t best_value = -1;
+        for (int64_t c = 0; c <= capacity; c++) {
+            int64_t total = (int64_t)left[c] + right[capacity - c];
+            if (total > best_value) {
+                best_value = total;
+                best_split = c;
+            }
+        }
+
+        recover(lo, mid, best_split, rows, take);
+        recover(mid, hi, capacity - best_split, rows, take);
+        return best_value;
+    }
+
+private:
+    const ScaledInstance& instance_;
+    int num_threads_;
+    MaxKernel kernel_;
+};
+
+} // namespace
+
+/**
+ * Converts an instance to integers for the DP engines.
+ *
+ * @param items Array of items
+ * @param n Number of items
+ * @param capacity Knapsack capacity
+ * @param out Output: the scaled instance
+ * @return true if weights and values scale to exact 32-bit integers
+ */
+bool scale_instance(const Item* items, int n, float capacity, ScaledInstance* out) {
+    if (n == 0) {
+        return false;
+    }
+    // Item is {id, value, weight}: stride through the array as floats
+    const int stride = sizeof(Item) / sizeof(float);
+    int64_t scale = integral_scale(&items[0].weight, n, stride);
+    int64_t value_scale = integral_scale(&items[0].value, n, stride);
+    if (scale == 0 || value_scale == 0) {
+        return false;
+    }
+
+    out->scale = scale;
+    out->value_scale = value_scale;
+    // Capacity is not scaled exactly (e.g. 2738.21f * 100 = 273820.99...),
+    // so round it up when it is within float rounding of the next integer
+    double scaled_capacity = (double)capacity * scale;
+    out->capacity = (int64_t)floor(scaled_capacity + float_tolerance(scaled_capacity));
+    out->weight.resize(n);
+    out->value.resize(n);
+
+    int64_t total_value = 0;
+    for (int i = 0; i < n; i++) {
+        int64_t w = (int64_t)floor((double)items[i].weight * scale + 0.5);
+        int64_t v = (int64_t)floor((double)items[i].value * value_scale + 0.5);
+        if (w < 0 || v < 0 || w > INT32_MAX) {
+            return false;
+        }
+        total_value += v;
+        out->weight[i] = (int32_t)w;
+        out->value[i] = (int32_t)v;
+    }
+    return out->capacity >= 0 && total_value <= INT32_MAX;
+}
+
+/**
+ * Dense dynamic-programming solver for 0/1 Knapsack.
+ *
+ * Weights, values and capacity are scaled to exact integers, then the
+ * optimum is found with a rolling-row DP over capacity whose inner max is a
+ * SIMD kernel (AVX2 or NEON, chosen at run time) and whose rows are split
+ * across OpenMP threads. The selected items are recovered by divide and
+ * conquer, so memory stays O(capacity) instead of O(n x capacity).
+ *
+ * Runs in O(n x capacity) time regardless of how correlated the items are,
+ * which beats branch and bound by orders of magnitude whenever the scaled
+ * capacity is modest. Instances that cannot be scaled, whose four rows
+ * would take more than DP_MAX_BYTES, or that would need more than
+ * DP_MAX_CELLS cell updates, are handed to branch_and_bound.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param options Optional settings; num_threads sizes the OpenMP team
+ */
+void dynamic_programming(Item* items, int n, float capacity,
+                         float* max_value, Item** best_items,
+                         int* best_count,
+                         int* nodes_explored_out, int* nodes_pruned_out,
+                         const SearchOptions* options) {
+    ScaledInstance instance;
+    bool scalable = scale_instance(items, n, capacity, &instance);
+    if (!scalable || rows_bytes(instance.capacity) > DP_MAX_BYTES ||
+        (int64_t)n * instance.capacity > DP_MAX_CELLS) {
+        print_info("DP not applicable (weights not integral or capacity too large); "
+                   "using branch and bound\n");
+        branch_and_bound(items, n, capacity, max_value, best_items, best_count,
+                         nodes_explored_out, nodes_pruned_out, options);
+        return;
+    }
+
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    if (options && options->num_threads > 0) {
+        num_threads = options->num_threads;
+    }
+
+    print_info("DP: weight scale %lld, value scale %lld, capacity %lld cells, %d thread(s)\n",
+               (long long)instance.scale, (long long)instance.value_scale,
+               (long long)instance.capacity, num_threads);
+
+    std::vector<int32_t> storage(4 * (instance.capacity + 1));
+    int32_t* rows[4];
+    for (int r = 0; r < 4; r++) {
+        rows[r] = storage.data() + r * (instance.capacity + 1);
+    }
+
+    DenseDP dp(instance, num_threads);
+    std::vector<char> take(n, 0);
+    dp.recover(0, n, instance.capacity, rows, take);
+
+    *best_items = new Item[n];
+    *best_count = 0;
+    *max_value = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (take[i]) {
+            (*best_items)[(*best_count)++] = items[i];
+            *max_value += items[i].value;
+        }
+    }
+
+    if (nodes_explored_out) {
+        *nodes_explored_out = 0;
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = 0;
+    }
+}
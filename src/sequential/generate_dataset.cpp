@@ -2,7 +2,12 @@
  * Dataset Generator for 0/1 Knapsack Problem
  * Generates test instances with configurable parameters and distributions
  * 
- * Usage: ./generate_dataset <num_items> <distribution_type> <capacity_percentage> <output_file>
+ * Usage: ./generate_dataset <num_items> <distribution_type> <capacity_percentage> <output_file> [format]
+ * 
+ * Formats:
+ *   text   - The text format of the data/ files (default)
+ *   binary - Binary instance the solvers memory-map (see
+ *            include/common/parser/instance_file.h)
  * 
  * Distribution types:
  *   uncorrelated      - Random values and weights (easiest for pruning)
@@ -10,6 +15,11 @@
  *   strongly_correlated - Value = weight + constant
  *   subset_sum        - Value = weight (hardest for branch & bound)
  *   inverse_strong    - High value = low weight (moderate difficulty)
+ * 
+ * Build:
+ *   g++ -std=c++11 -O2 -Iinclude/common src/sequential/generate_dataset.cpp \
+ *       src/common/instance_generator.cpp src/common/parser/instance_file.cpp \
+ *       -o generate_dataset
  */
 
 #include <stdio.h>
@@ -17,103 +27,69 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <vector>
+#include "parser/instance_file.h"
+#include "instance_generator.h"
 
-// Random float between min and max
-float rand_range(float min, float max) {
-    return min + (float)rand() / RAND_MAX * (max - min);
-}
-
-// Random integer between min and max (inclusive)
-int rand_int(int min, int max) {
-    return min + rand() % (max - min + 1);
-}
-
-void generate_dataset(int num_items, const char* distribution, float capacity_pct, const char* output_file) {
+void write_text(const Dataset& dataset, float capacity, const char* output_file) {
     FILE* file = fopen(output_file, "w");
     if (!file) {
         fprintf(stderr, "Error: Could not create output file %s\n", output_file);
         exit(1);
     }
-    
+    int num_items = (int)dataset.values.size();
+    fprintf(file, "%d\n", num_items);
+    for (int i = 0; i < num_items; i++) {
+        fprintf(file, "%d %.2f %.2f\n", i, dataset.values[i], dataset.weights[i]);
+    }
+    fprintf(file, "%.2f\n", capacity);
+    fclose(file);
+}
+
+void write_binary(const Dataset& dataset, float capacity, const char* output_file) {
+    int num_items = (int)dataset.values.size();
+    std::vector<int32_t> ids(num_items);
+    for (int i = 0; i < num_items; i++) {
+        ids[i] = i;
+    }
+    if (!write_instance_file(output_file, dataset.weights.data(), dataset.values.data(),
+                             ids.data(), num_items, two_decimals(capacity))) {
+        exit(1);
+    }
+}
+
+void generate_dataset(int num_items, const char* distribution, float capacity_pct,
+                      const char* output_file, bool binary) {
     // Seed random number generator
     srand(time(NULL) + rand());
     
-    // Write number of items
-    fprintf(file, "%d\n", num_items);
-    
-    float total_weight = 0.0f;
-    
-    // Generate items based on distribution type
-    if (strcmp(distribution, "uncorrelated") == 0) {
-        // Uncorrelated: completely random values and weights
-        for (int i = 0; i < num_items; i++) {
-            float weight = rand_range(1.0f, 100.0f);
-            float value = rand_range(1.0f, 100.0f);
-            fprintf(file, "%d %.2f %.2f\n", i, value, weight);
-            total_weight += weight;
-        }
-        
-    } else if (strcmp(distribution, "weakly_correlated") == 0) {
-        // Weakly correlated: value ≈ weight + noise
-        for (int i = 0; i < num_items; i++) {
-            float weight = rand_range(1.0f, 100.0f);
-            float value = weight + rand_range(-10.0f, 10.0f);
-            if (value < 1.0f) value = 1.0f; // Keep positive
-            fprintf(file, "%d %.2f %.2f\n", i, value, weight);
-            total_weight += weight;
-        }
-        
-    } else if (strcmp(distribution, "strongly_correlated") == 0) {
-        // Strongly correlated: value = weight + constant
-        float constant = 10.0f;
-        for (int i = 0; i < num_items; i++) {
-            float weight = rand_range(1.0f, 100.0f);
-            float value = weight + constant;
-            fprintf(file, "%d %.2f %.2f\n", i, value, weight);
-            total_weight += weight;
-        }
-        
-    } else if (strcmp(distribution, "subset_sum") == 0) {
-        // Subset sum: value = weight (hardest for branch & bound)
-        for (int i = 0; i < num_items; i++) {
-            float weight = rand_range(1.0f, 100.0f);
-            float value = weight; // Same as weight
-            fprintf(file, "%d %.2f %.2f\n", i, value, weight);
-            total_weight += weight;
-        }
-        
-    } else if (strcmp(distribution, "inverse_strong") == 0) {
-        // Inverse strongly correlated: high value = low weight
-        for (int i = 0; i < num_items; i++) {
-            float weight = rand_range(1.0f, 100.0f);
-            float value = 100.0f - weight + rand_range(10.0f, 30.0f);
-            fprintf(file, "%d %.2f %.2f\n", i, value, weight);
-            total_weight += weight;
-        }
-        
-    } else {
+    Dataset dataset;
+    if (!generate_items(num_items, distribution, &dataset)) {
         fprintf(stderr, "Error: Unknown distribution type '%s'\n", distribution);
         fprintf(stderr, "Valid types: uncorrelated, weakly_correlated, strongly_correlated, subset_sum, inverse_strong\n");
-        fclose(file);
         exit(1);
     }
+    float total_weight = dataset.total_weight;
     
     // Calculate capacity based on percentage of total weight
     float capacity = total_weight * (capacity_pct / 100.0f);
-    fprintf(file, "%.2f\n", capacity);
-    
-    fclose(file);
+    if (binary) {
+        write_binary(dataset, capacity, output_file);
+    } else {
+        write_text(dataset, capacity, output_file);
+    }
     
     printf("Generated dataset: %s\n", output_file);
     printf("  Items: %d\n", num_items);
     printf("  Distribution: %s\n", distribution);
+    printf("  Format: %s\n", binary ? "binary" : "text");
     printf("  Total weight: %.2f\n", total_weight);
     printf("  Capacity: %.2f (%.0f%% of total)\n", capacity, capacity_pct);
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 5) {
-        printf("Usage: %s <num_items> <distribution> <capacity_pct> <output_file>\n", argv[0]);
+    if (argc != 5 && argc != 6) {
+        printf("Usage: %s <num_items> <distribution> <capacity_pct> <output_file> [format]\n", argv[0]);
         printf("\nDistribution types:\n");
         printf("  uncorrelated       - Random values and weights\n");
         printf("  weakly_correlated  - Value ≈ weight + noise\n");
@@ -121,7 +97,9 @@ int main(int argc, char* argv[]) {
         printf("  subset_sum         - Value = weight (hardest)\n");
         printf("  inverse_strong     - High value = low weight\n");
         printf("\nCapacity percentage: 0-100 (e.g., 50 for 50%% of total weight)\n");
+        printf("\nFormats: text (default), binary (memory-mapped by the solvers)\n");
         printf("\nExample: %s 500 subset_sum 50 data/hard_500.txt\n", argv[0]);
+        printf("         %s 10000000 weakly_correlated 50 data/weak_10m.bin binary\n", argv[0]);
         return 1;
     }
     
@@ -129,6 +107,7 @@ int main(int argc, char* argv[]) {
     const char* distribution = argv[2];
     float capacity_pct = atof(argv[3]);
     const char* output_file = argv[4];
+    const char* format = argc == 6 ? argv[5] : "text";
     
     if (num_items <= 0) {
         fprintf(stderr, "Error: Number of items must be positive\n");
@@ -140,7 +119,13 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    generate_dataset(num_items, distribution, capacity_pct, output_file);
+    if (strcmp(format, "text") != 0 && strcmp(format, "binary") != 0) {
+        fprintf(stderr, "Error: Format must be text or binary\n");
+        return 1;
+    }
+    
+    generate_dataset(num_items, distribution, capacity_pct, output_file,
+                     strcmp(format, "binary") == 0);
     
     return 0;
 }
@@ -10,10 +10,36 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "parser/parser.h"
-#include "branch_and_bound.h"
+#include "solvers.h"
+#include "search_options.h"
 #include "test_config.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Optional frontier memory budget in MiB (0 or absent: unlimited)
+    SearchOptions options;
+    if (argc > 1) {
+        double budget_mb = atof(argv[1]);
+        if (budget_mb < 0.0) {
+            printf("Error: Frontier budget must be >= 0 MiB\n");
+            return 1;
+        }
+        options.frontier_budget_bytes = (size_t)(budget_mb * 1024.0 * 1024.0);
+    }
+
+    // Optional engine: bnb (branch and bound, default), bnb_mt2, bnb_mm,
+    // bnb_fixed, dp, subset, pareto or mitm
+    const char* engine = argc > 2 ? argv[2] : "bnb";
+    Solver solver = solver_for(engine);
+    if (solver == nullptr) {
+        printf("Error: Unknown engine '%s' (expected bnb, bnb_mt2, bnb_mm, bnb_fixed, dp, subset, pareto or mitm)\n", engine);
+        return 1;
+    }
+
+    // Optional reduced-cost variable fixing: 1 (default) or 0 to disable
+    if (argc > 3) {
+        options.fix_variables = atoi(argv[3]) != 0;
+    }
+    
     // Load items and capacity from input file
     int item_count = 0;
     float capacity = 0.0f;
@@ -26,16 +52,18 @@ int main() {
     
     printf("Test file: %s\n", TEST_FILE);
     printf("Loaded %d items from data file.\n", item_count);
-    printf("Knapsack capacity: %.2f\n\n", capacity);
+    printf("Knapsack capacity: %.2f\n", capacity);
+    printf("Engine: %s\n\n", engine);
     
     // Initialize solution variables
     float max_value = 0.0f;
     Item* best_items = nullptr;
     int best_count = 0;
     
-    // Execute branch and bound algorithm
-    TreeNode* solution_tree = branch_and_bound(items, item_count, capacity, 
-                                               &max_value, &best_items, &best_count);
+    // Execute the selected engine
+    run_solver(solver, items, item_count, capacity,
+               &max_value, &best_items, &best_count,
+               nullptr, nullptr, &options);
     
     // Display optimal solution
     printf("\n========== OPTIMAL SOLUTION ==========\n");
@@ -54,7 +82,6 @@ int main() {
     printf("======================================\n");
     
     // Free dynamically allocated memory
-    delete solution_tree;
     delete[] best_items;
     delete[] items;
     
@@ -0,0 +1,545 @@
+#include <float.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "meet_in_the_middle.h"
+#include "branch_and_bound.h"
+#include "knapsack_utils.h"
+#include "prefix_bound.h"
+#include "output_display.h"
+#include "primal_heuristic.h"
+
+namespace {
+
+// Lists shorter than this are built and sorted on one thread
+const size_t MITM_PARALLEL_MIN = 1 << 16;
+
+/**
+ * Float rounding of a combination's weight. The lists add the weights in
+ * another order than the search does, so the same combination can come out
+ * a few ulps either side of the capacity; for n items the two sums differ
+ * by less than this. Combinations within it are only candidates: each one
+ * is taken only if fits_in_item_order() accepts it.
+ */
+inline float rounding_band(int n, float capacity) {
+    return (n + 1) * FLT_EPSILON * capacity;
+}
+
+// Radix sort digit width
+const int RADIX_BITS = 8;
+const int RADIX = 1 << RADIX_BITS;
+
+/**
+ * One subset of a group of items: its total weight and value, and which of
+ * the group's items it takes (bit i for the group's item i).
+ */
+struct Subset {
+    float weight;
+    float value;
+    uint32_t mask;
+};
+
+typedef std::vector<Subset> SubsetList;
+
+// Non-negative floats order the same as their bit patterns
+inline uint32_t weight_key(const Subset& s) {
+    uint32_t key;
+    memcpy(&key, &s.weight, sizeof(key));
+    return key;
+}
+
+/**
+ * Enumerates all 2^count subsets of items[0, count) by doubling: the
+ * subsets taking item b are the ones before it shifted by item b. Each
+ * doubling step is split across the OpenMP team once it is large enough.
+ */
+void enumerate(const Item* items, int count, int num_threads, SubsetList* out) {
+    const size_t size = (size_t)1 << count;
+    out->resize(size);
+    Subset* list = out->data();
+    list[0].weight = 0.0f;
+    list[0].value = 0.0f;
+    list[0].mask = 0;
+    for (int b = 0; b < count; b++) {
+        const int64_t half = (int64_t)1 << b;
+        const float w = items[b].weight;
+        const float v = items[b].value;
+        #pragma omp parallel for num_threads(num_threads) if((size_t)half >= MITM_PARALLEL_MIN) schedule(static)
+        for (int64_t m = 0; m < half; m++) {
+            Subset s = list[m];
+            s.weight += w;
+            s.value += v;
+            s.mask |= 1u << b;
+            list[half + m] = s;
+        }
+    }
+}
+
+/**
+ * Stable LSD radix sort of a list by weight, one byte per pass. Every pass
+ * counts digits per block of the list, turns the counts into per-block
+ * output offsets and scatters each block independently, so blocks run on
+ * separate threads. Passes where every key has the same digit are skipped.
+ */
+void radix_sort(SubsetList* list, SubsetList* scratch, int num_threads) {
+    const size_t size = list->size();
+    scratch->resize(size);
+    const int blocks = size >= MITM_PARALLEL_MIN ? std::max(1, num_threads) : 1;
+    const size_t block_size = (size + blocks - 1) / blocks;
+    std::vector<size_t> counts((size_t)blocks * RADIX);
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        std::fill(counts.begin(), counts.end(), 0);
+        const Subset* in = list->data();
+        Subset* out = scratch->data();
+
+        #pragma omp parallel for num_threads(num_threads) if(blocks > 1) schedule(static, 1)
+        for (int b = 0; b < blocks; b++) {
+            size_t* count = &counts[(size_t)b * RADIX];
+            size_t end = std::min(size, (b + 1) * block_size);
+            for (size_t i = b * block_size; i < end; i++) {
+                count[(weight_key(in[i]) >> shift) & (RADIX - 1)]++;
+            }
+        }
+
+        // Exclusive offsets, digit-major then block order (keeps it stable)
+        bool single_digit = false;
+        size_t offset = 0;
+        for (int d = 0; d < RADIX; d++) {
+            size_t digit_total = 0;
+            for (int b = 0; b < blocks; b++) {
+                size_t c = counts[(size_t)b * RADIX + d];
+                counts[(size_t)b * RADIX + d] = offset;
+                offset += c;
+                digit_total += c;
+            }
+            single_digit = single_digit || digit_total == size;
+        }
+        if (single_digit) {
+            continue;
+        }
+
+        #pragma omp parallel for num_threads(num_threads) if(blocks > 1) schedule(static, 1)
+        for (int b = 0; b < blocks; b++) {
+            size_t* next = &counts[(size_t)b * RADIX];
+            size_t end = std::min(size, (b + 1) * block_size);
+            for (size_t i = b * block_size; i < end; i++) {
+                out[next[(weight_key(in[i]) >> shift) & (RADIX - 1)]++] = in[i];
+            }
+        }
+        list->swap(*scratch);
+    }
+}
+
+/**
+ * Builds the sorted list of useful subsets of a group of items: every
+ * subset no heavier than limit, in weight order, keeping only those more
+ * valuable than every lighter one. Any solution using a dropped subset is matched by one
+ * using the subset that dominates it.
+ */
+void build_list(const Item* items, int count, float limit, int num_threads,
+                SubsetList* list, SubsetList* scratch) {
+    enumerate(items, count, num_threads, list);
+    radix_sort(list, scratch, num_threads);
+
+    size_t kept = 0;
+    float last_value = -1.0f;
+    for (size_t i = 0; i < list->size(); i++) {
+        const Subset s = (*list)[i];
+        if (s.weight > limit) {
+            break;
+        }
+        if (s.value > last_value) {
+            // Same weight as the last kept subset: the new one replaces it
+            if (kept > 0 && (*list)[kept - 1].weight == s.weight) {
+                kept--;
+            }
+            (*list)[kept++] = s;
+            last_value = s.value;
+        }
+    }
+    list->resize(kept);
+}
+
+/**
+ * Whether a combination fits with its weights added in item order, exactly
+ * as a search path adds them; part g covers items [offset[g], offset[g + 1]).
+ */
+bool fits_in_item_order(const Item* items, const uint32_t* masks, const int* offset,
+                        int parts, float capacity) {
+    float weight = 0.0f;
+    for (int g = 0; g < parts; g++) {
+        for (int i = offset[g]; i < offset[g + 1]; i++) {
+            if ((masks[g] >> (i - offset[g])) & 1u) {
+                weight += items[i].weight;
+            }
+        }
+    }
+    return weight <= capacity;
+}
+
+/**
+ * Sum of one subset from each of two sorted lists, as kept in the heaps
+ * that stream the pair sums in weight order.
+ */
+struct PairSum {
+    float weight;
+    int32_t first;
+    int32_t second;
+};
+
+struct LighterFirst {
+    bool operator()(const PairSum& a, const PairSum& b) const {
+        return a.weight > b.weight;
+    }
+};
+
+struct HeavierFirst {
+    bool operator()(const PairSum& a, const PairSum& b) const {
+        return a.weight < b.weight;
+    }
+};
+
+/**
+ * Best combination found so far, as a take flag per item.
+ */
+struct Incumbent {
+    float value;
+    std::vector<char> take;
+
+    // Records a new best from the masks of its parts, part g covering
+    // items [offset[g], offset[g + 1])
+    void update(float new_value, const uint32_t* masks, const int* offset, int parts) {
+        value = new_value;
+        for (int g = 0; g < parts; g++) {
+            for (int i = offset[g]; i < offset[g + 1]; i++) {
+                take[i] = (masks[g] >> (i - offset[g])) & 1u;
+            }
+        }
+    }
+};
+
+/**
+ * Horowitz-Sahni: both halves as full sorted lists. Their values increase
+ * with weight, so the best partner of a subset of the first half is the
+ * heaviest subset of the second that still fits, and one pass with two
+ * pointers (first half ascending, second half descending) finds the optimum.
+ * The pointer stops within the rounding band, so the partners from there
+ * down are checked in item order until one fits.
+ */
+long long solve_halves(const Item* items, int n, float capacity, float lp_bound,
+                       int num_threads, Incumbent* best) {
+    const int first_count = n / 2;
+    const int offset[3] = {0, first_count, n};
+    const float limit = capacity + rounding_band(n, capacity);
+    SubsetList first, second, scratch;
+    build_list(items, first_count, limit, num_threads, &first, &scratch);
+    build_list(items + first_count, n - first_count, limit, num_threads, &second, &scratch);
+    print_info("Meet in the middle (Horowitz-Sahni): %zu + %zu undominated subsets\n",
+               first.size(), second.size());
+
+    long long combined = 0;
+    size_t j = second.size();
+    for (size_t i = 0; i < first.size(); i++) {
+        while (j > 0 && first[i].weight + second[j - 1].weight > limit) {
+            j--;
+        }
+        if (j == 0) {
+            break;
+        }
+        combined++;
+        for (size_t k = j; k > 0; k--) {
+            float value = first[i].value + second[k - 1].value;
+            if (value <= best->value) {
+                break;
+            }
+            uint32_t masks[2] = {first[i].mask, second[k - 1].mask};
+            if (fits_in_item_order(items, masks, offset, 2, capacity)) {
+                best->update(value, masks, offset, 2);
+                break;
+            }
+        }
+        if (!can_improve(lp_bound, best->value)) {
+            break;
+        }
+    }
+    return combined;
+}
+
+/**
+ * Schroeppel-Shamir: the items are split into quarters and only the four
+ * quarter lists are stored. The sums of the first two quarters are streamed
+ * heaviest first from a max-heap holding one candidate per subset of
+ * quarter 1; the sums of the last two lightest first from a min-heap. As
+ * the left sum gets lighter, every right sum that now fits is taken from
+ * the stream and folded into a running maximum, which is the best partner
+ * for the current left sum; right sums that fit only within the rounding
+ * band are held back and checked in item order until the left sums are
+ * light enough for them to fit for sure. Memory is O(2^(n/4)); time is
+ * O(2^(n/2)) in the worst case, but left sums that cannot beat the
+ * incumbent, by the fractional bound of their q1 subset or with the most
+ * valuable right sum, are never streamed.
+ */
+long long solve_quarters(const Item* items, int n, float capacity, float lp_bound,
+                         int num_threads, Incumbent* best) {
+    int offset[5];
+    offset[0] = 0;
+    offset[2] = n / 2;
+    offset[1] = offset[2] / 2;
+    offset[3] = offset[2] + (n - offset[2]) / 2;
+    offset[4] = n;
+
+    const float band = rounding_band(n, capacity);
+    const float limit = capacity + band;
+    const float sure = capacity - band;
+    SubsetList quarter[4], scratch;
+    for (int q = 0; q < 4; q++) {
+        build_list(items + offset[q], offset[q + 1] - offset[q], limit,
+                   num_threads, &quarter[q], &scratch);
+    }
+    print_info("Meet in the middle (Schroeppel-Shamir): %zu, %zu, %zu, %zu undominated subsets\n",
+               quarter[0].size(), quarter[1].size(), quarter[2].size(), quarter[3].size());
+
+    const SubsetList& q1 = quarter[0];
+    const SubsetList& q2 = quarter[1];
+    const SubsetList& q3 = quarter[2];
+    const SubsetList& q4 = quarter[3];
+
+    // No right sum is worth more than the best of q3 plus the best of q4.
+    // Values grow with weight along a list, so once a left sum plus this
+    // cannot beat the incumbent, neither can any lighter partner in q2 and
+    // its successors are never pushed
+    const float right_max = q3.back().value + q4.back().value;
+
+    // Items are in ratio order, so everything after quarter 1 is a ratio
+    // ordered tail: the fractional bound over it caps every solution that
+    // extends a subset of q1, and such a chain is dropped once it cannot
+    // beat the incumbent
+    PrefixBound tail(items + offset[1], n - offset[1], capacity);
+    std::vector<float> chain_bound(q1.size());
+    for (size_t i = 0; i < q1.size(); i++) {
+        int critical = 0;
+        // A subset that fills the knapsack exactly gets bound 0 from
+        // PrefixBound, but is still a solution worth its own value
+        chain_bound[i] = std::max(q1[i].value,
+                                  tail.bound(-1, q1[i].weight, q1[i].value, &critical));
+    }
+
+    // Left: start each subset of q1 at its heaviest fitting partner in q2
+    std::priority_queue<PairSum, std::vector<PairSum>, HeavierFirst> left;
+    for (size_t i = 0; i < q1.size(); i++) {
+        if (!can_improve(chain_bound[i], best->value)) {
+            continue;
+        }
+        // Binary search for the first partner that no longer fits
+        int32_t lo = 0;
+        int32_t hi = (int32_t)q2.size();
+        while (lo < hi) {
+            int32_t mid = lo + (hi - lo) / 2;
+            if (q1[i].weight + q2[mid].weight <= limit) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo > 0 && can_improve(q1[i].value + q2[lo - 1].value + right_max, best->value)) {
+            PairSum p = {q1[i].weight + q2[lo - 1].weight, (int32_t)i, lo - 1};
+            left.push(p);
+        }
+    }
+
+    // Right: start each subset of q3 at the empty subset of q4
+    std::priority_queue<PairSum, std::vector<PairSum>, LighterFirst> right;
+    for (size_t k = 0; k < q3.size(); k++) {
+        PairSum p = {q3[k].weight + q4[0].weight, (int32_t)k, 0};
+        right.push(p);
+    }
+
+    long long combined = 0;
+    float right_best = -1.0f;  // Most valuable right sum that surely fits so far
+    int32_t right_k = 0;
+    int32_t right_l = 0;
+    std::vector<PairSum> pending;  // Right sums within the rounding band
+    while (!left.empty()) {
+        PairSum l = left.top();
+        left.pop();
+        if (l.second > 0 && can_improve(chain_bound[l.first], best->value) &&
+            can_improve(q1[l.first].value + q2[l.second - 1].value + right_max, best->value)) {
+            PairSum next = {q1[l.first].weight + q2[l.second - 1].weight, l.first, l.second - 1};
+            left.push(next);
+        }
+
+        while (!right.empty() && l.weight + right.top().weight <= limit) {
+            PairSum r = right.top();
+            right.pop();
+            if (l.weight + r.weight > sure) {
+                pending.push_back(r);
+            } else {
+                float value = q3[r.first].value + q4[r.second].value;
+                if (value > right_best) {
+                    right_best = value;
+                    right_k = r.first;
+                    right_l = r.second;
+                }
+            }
+            // Later sums of this chain only matter if they beat the running
+            // maximum: skip straight to the first one that does (q4 values
+            // grow along the list)
+            int32_t lo = r.second + 1;
+            int32_t hi = (int32_t)q4.size();
+            while (lo < hi) {
+                int32_t mid = lo + (hi - lo) / 2;
+                if (q3[r.first].value + q4[mid].value > right_best) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            if (lo < (int32_t)q4.size()) {
+                PairSum next = {q3[r.first].weight + q4[lo].weight, r.first, lo};
+                right.push(next);
+            }
+        }
+
+        // Left sums only get lighter: fold the right sums that now fit for
+        // sure into the running maximum
+        size_t kept = 0;
+        for (size_t p = 0; p < pending.size(); p++) {
+            const PairSum& r = pending[p];
+            if (l.weight + r.weight > sure) {
+                pending[kept++] = r;
+                continue;
+            }
+            float value = q3[r.first].value + q4[r.second].value;
+            if (value > right_best) {
+                right_best = value;
+                right_k = r.first;
+                right_l = r.second;
+            }
+        }
+        pending.resize(kept);
+        if (right_best < 0.0f && pending.empty()) {
+            continue;
+        }
+
+        // Best partner: the running maximum or a held back sum that fits
+        // in item order
+        combined++;
+        const float left_value = q1[l.first].value + q2[l.second].value;
+        for (size_t p = 0; p <= pending.size(); p++) {
+            int32_t k = right_k;
+            int32_t m = right_l;
+            float value = left_value + right_best;
+            if (p < pending.size()) {
+                k = pending[p].first;
+                m = pending[p].second;
+                value = left_value + q3[k].value + q4[m].value;
+            } else if (right_best < 0.0f) {
+                break;
+            }
+            if (value <= best->value) {
+                continue;
+            }
+            uint32_t masks[4] = {q1[l.first].mask, q2[l.second].mask, q3[k].mask, q4[m].mask};
+            if (fits_in_item_order(items, masks, offset, 4, capacity)) {
+                best->update(value, masks, offset, 4);
+            }
+        }
+        if (!can_improve(lp_bound, best->value)) {
+            break;
+        }
+    }
+    return combined;
+}
+
+} // namespace
+
+/**
+ * Meet-in-the-middle solver for 0/1 Knapsack.
+ *
+ * Splits the items into two halves, lists the subsets of each half sorted
+ * by weight (radix sort) with dominated subsets removed, and pairs them up
+ * with a two-pointer merge. Up to MITM_HALF_MAX_ITEMS items the half lists
+ * are stored whole (Horowitz-Sahni); up to MITM_MAX_ITEMS they are streamed
+ * from quarter lists through two heaps instead (Schroeppel-Shamir). The
+ * search stops early once a solution reaches the fractional bound.
+ *
+ * Its running time depends only on n, not on how correlated the items are
+ * or on the capacity, so it beats branch and bound on small hard instances.
+ * Larger instances are handed to branch_and_bound.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param options Optional settings; num_threads sizes the OpenMP team
+ */
+void meet_in_the_middle(Item* items, int n, float capacity,
+                        float* max_value, Item** best_items,
+                        int* best_count,
+                        int* nodes_explored_out, int* nodes_pruned_out,
+                        const SearchOptions* options) {
+    if (n > MITM_MAX_ITEMS) {
+        print_info("Meet in the middle limited to %d items; using branch and bound\n",
+                   MITM_MAX_ITEMS);
+        branch_and_bound(items, n, capacity, max_value, best_items, best_count,
+                         nodes_explored_out, nodes_pruned_out, options);
+        return;
+    }
+
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    if (options && options->num_threads > 0) {
+        num_threads = options->num_threads;
+    }
+
+    // Ratio order only serves the fractional bound used to stop early
+    sort_items(items, n);
+    print_sorted_items(items, n);
+    int critical = 0;
+    float lp_bound = PrefixBound(items, n, capacity).bound(-1, 0.0f, 0.0f, &critical);
+
+    // Start from the primal heuristic, so the quarter streams prune at once
+    HeuristicSolution seed;
+    primal_heuristic(items, n, capacity, 0, &seed);
+    Incumbent best;
+    best.value = seed.value;
+    best.take.resize(n);
+    for (int i = 0; i < n; i++) {
+        best.take[i] = (seed.decisions[i / 64] >> (i % 64)) & 1;
+    }
+    long long combined;
+    if (n <= MITM_HALF_MAX_ITEMS) {
+        combined = solve_halves(items, n, capacity, lp_bound, num_threads, &best);
+    } else {
+        combined = solve_quarters(items, n, capacity, lp_bound, num_threads, &best);
+    }
+    print_info("Meet in the middle: %lld subset sums combined\n", combined);
+
+    *best_items = new Item[n];
+    *best_count = 0;
+    *max_value = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (best.take[i]) {
+            (*best_items)[(*best_count)++] = items[i];
+            *max_value += items[i].value;
+        }
+    }
+
+    if (nodes_explored_out) {
+        *nodes_explored_out = (int)std::min<long long>(combined, INT32_MAX);
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = 0;
+    }
+}
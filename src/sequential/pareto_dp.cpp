@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "pareto_dp.h"
+#include "branch_and_bound.h"
+#include "knapsack_utils.h"
+#include "prefix_bound.h"
+#include "output_display.h"
+#include "primal_heuristic.h"
+
+namespace {
+
+/**
+ * Pareto frontier of partial solutions as structure-of-arrays.
+ * States are sorted by weight with strictly increasing value, so no state
+ * is dominated by another (lighter and at least as valuable).
+ */
+struct StateList {
+    std::vector<float> weight;
+    std::vector<float> value;
+    std::vector<int32_t> trace;  // Index of the state's entry in its level trace
+
+    void clear() {
+        weight.clear();
+        value.clear();
+        trace.clear();
+    }
+
+    size_t size() const {
+        return weight.size();
+    }
+
+    void push(float w, float v, int32_t t) {
+        weight.push_back(w);
+        value.push_back(v);
+        trace.push_back(t);
+    }
+};
+
+/**
+ * How the states kept at one level were formed: the previous level's trace
+ * entry they extend and whether they took this level's item. Only states
+ * that survive pruning (plus the incumbent) get an entry, so the item set
+ * of any recorded state can be recovered by walking back level by level.
+ */
+struct LevelTrace {
+    std::vector<int32_t> parent;
+    std::vector<char> taken;
+
+    int32_t add(int32_t from, bool take) {
+        parent.push_back(from);
+        taken.push_back(take);
+        return (int32_t)parent.size() - 1;
+    }
+};
+
+} // namespace
+
+/**
+ * Sparse dynamic programming (Nemhauser-Ullmann) for 0/1 Knapsack.
+ *
+ * Instead of a table over every capacity, keeps only the non-dominated
+ * (weight, value) states. Adding an item merges the list with a copy of
+ * itself shifted by the item's weight and value; both inputs are sorted by
+ * weight, so a linear two-pointer merge produces the next sorted list and
+ * drops dominated states on the way. Works on float weights and capacities
+ * of any size, where a dense DP cannot be used at all.
+ *
+ * With items in ratio order, each state is also a branch and bound node:
+ * states whose fractional bound (PrefixBound, equivalent to
+ * calculate_bound) cannot beat the best value seen are dropped, which keeps
+ * the lists short on all but the most correlated instances.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param options Optional settings, passed on to the fallback engine
+ */
+void pareto_dp(Item* items, int n, float capacity,
+               float* max_value, Item** best_items,
+               int* best_count,
+               int* nodes_explored_out, int* nodes_pruned_out,
+               const SearchOptions* options) {
+    // Ratio order makes the bound tight
+    sort_items(items, n);
+    print_sorted_items(items, n);
+
+    PrefixBound bounds(items, n, capacity);
+
+    // Live frontier and the merge buffer it is rebuilt into
+    StateList current;
+    StateList merged;
+    std::vector<char> merged_taken;  // Whether each merged state took item i
+    current.push(0.0f, 0.0f, -1);  // Empty knapsack
+
+    // The primal heuristic gives a feasible starting incumbent, so the
+    // bound prunes from the first level on
+    HeuristicSolution seed;
+    primal_heuristic(items, n, capacity, 0, &seed);
+    std::vector<char> take(n, 0);
+    for (int i = 0; i < n; i++) {
+        take[i] = (seed.decisions[i / 64] >> (i % 64)) & 1;
+    }
+
+    std::vector<LevelTrace> traces(n);
+    float best_value = seed.value;
+    int best_level = -1;     // Level and trace entry of the incumbent state
+    int32_t best_trace = -1;
+
+    long long states_generated = 0;
+    long long states_pruned = 0;
+    size_t peak_states = 1;
+
+    for (int i = 0; i < n && current.size() > 0; i++) {
+        const float w = items[i].weight;
+        const float v = items[i].value;
+        const size_t count = current.size();
+
+        // Merge "skip item i" (current list) with "take item i" (current
+        // list shifted by w, v), both in weight order. A state survives
+        // only if it is more valuable than every lighter state
+        merged.clear();
+        merged_taken.clear();
+        size_t a = 0;
+        size_t b = 0;
+        float last_value = -1.0f;
+        while (a < count || b < count) {
+            float take_weight = b < count ? current.weight[b] + w : 0.0f;
+            bool take_fits = b < count && take_weight <= capacity;
+            if (!take_fits) {
+                b = count;  // Shifted list is sorted: the rest do not fit either
+            }
+
+            bool from_take;
+            if (a == count) {
+                if (!take_fits) {
+                    break;
+                }
+                from_take = true;
+            } else if (!take_fits) {
+                from_take = false;
+            } else if (take_weight != current.weight[a]) {
+                from_take = take_weight < current.weight[a];
+            } else {
+                // Same weight: emit the more valuable one first so the
+                // other is dropped as dominated
+                from_take = current.value[b] + v > current.value[a];
+            }
+
+            float state_weight, state_value;
+            int32_t state_trace;
+            if (from_take) {
+                state_weight = take_weight;
+                state_value = current.value[b] + v;
+                state_trace = current.trace[b];
+                b++;
+            } else {
+                state_weight = current.weight[a];
+                state_value = current.value[a];
+                state_trace = current.trace[a];
+                a++;
+            }
+
+            states_generated++;
+            if (state_value > last_value) {
+                merged.push(state_weight, state_value, state_trace);
+                merged_taken.push_back(from_take);
+                last_value = state_value;
+            }
+        }
+
+        // Values increase along the list, so the last state is the best one
+        size_t best_index = merged.size();
+        if (merged.size() > 0 && merged.value.back() > best_value) {
+            best_value = merged.value.back();
+            best_index = merged.size() - 1;
+        }
+
+        // Keep states whose bound can still beat the incumbent; the
+        // incumbent itself is traced even if nothing can extend it
+        current.clear();
+        int critical = i + 1;
+        for (size_t k = 0; k < merged.size(); k++) {
+            float bound = bounds.bound(i, merged.weight[k], merged.value[k], &critical);
+            bool keep = i < n - 1 && can_improve(bound, best_value);
+            if (!keep && k != best_index) {
+                states_pruned++;
+                continue;
+            }
+            int32_t entry = traces[i].add(merged.trace[k], merged_taken[k]);
+            if (k == best_index) {
+                best_level = i;
+                best_trace = entry;
+            }
+            if (keep) {
+                current.push(merged.weight[k], merged.value[k], entry);
+            } else {
+                states_pruned++;
+            }
+        }
+
+        peak_states = std::max(peak_states, current.size());
+        if (current.size() > (size_t)PARETO_MAX_STATES) {
+            print_info("Pareto frontier exceeded %d states; using branch and bound\n",
+                       PARETO_MAX_STATES);
+            branch_and_bound(items, n, capacity, max_value, best_items, best_count,
+                             nodes_explored_out, nodes_pruned_out, options);
+            return;
+        }
+    }
+
+    print_info("Pareto DP: peak frontier %zu states\n", peak_states);
+    print_statistics((int)std::min<long long>(states_generated, INT32_MAX),
+                     (int)std::min<long long>(states_pruned, INT32_MAX));
+
+    // Walk the trace back from the incumbent state to recover its items;
+    // if no state beat the heuristic, take already holds its items
+    if (best_level >= 0) {
+        std::fill(take.begin(), take.end(), 0);
+    }
+    for (int level = best_level; level >= 0; level--) {
+        take[level] = traces[level].taken[best_trace];
+        best_trace = traces[level].parent[best_trace];
+    }
+
+    *best_items = new Item[n];
+    *best_count = 0;
+    *max_value = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (take[i]) {
+            (*best_items)[(*best_count)++] = items[i];
+            *max_value += items[i].value;
+        }
+    }
+
+    if (nodes_explored_out) {
+        *nodes_explored_out = (int)std::min<long long>(states_generated, INT32_MAX);
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = (int)std::min<long long>(states_pruned, INT32_MAX);
+    }
+}
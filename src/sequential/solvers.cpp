@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <string.h>
+#include "solvers.h"
+#include "branch_and_bound.h"
+#include "dynamic_programming.h"
+#include "subset_sum.h"
+#include "pareto_dp.h"
+#include "meet_in_the_middle.h"
+#include "variable_fixing.h"
+
+Solver solver_for(const char* engine) {
+    if (strcmp(engine, "bnb") == 0) {
+        return branch_and_bound;
+    }
+    if (strcmp(engine, "bnb_mt2") == 0) {
+        return branch_and_bound_with<MartelloTothBound>;
+    }
+    if (strcmp(engine, "bnb_mm") == 0) {
+        return branch_and_bound_with<MullerMerbachBound>;
+    }
+    if (strcmp(engine, "bnb_fixed") == 0) {
+        return branch_and_bound_fixed;
+    }
+    if (strcmp(engine, "dp") == 0) {
+        return dynamic_programming;
+    }
+    if (strcmp(engine, "subset") == 0) {
+        return subset_sum;
+    }
+    if (strcmp(engine, "pareto") == 0) {
+        return pareto_dp;
+    }
+    if (strcmp(engine, "mitm") == 0) {
+        return meet_in_the_middle;
+    }
+    return nullptr;
+}
+
+void run_solver(Solver solver, Item* items, int n, float capacity,
+                float* max_value, Item** best_items,
+                int* best_count,
+                int* nodes_explored_out, int* nodes_pruned_out,
+                const SearchOptions* options) {
+    if (!options || !options->fix_variables) {
+        solver(items, n, capacity, max_value, best_items, best_count,
+               nodes_explored_out, nodes_pruned_out, options);
+        return;
+    }
+
+    // Nothing is searched if every item is fixed
+    if (nodes_explored_out) {
+        *nodes_explored_out = 0;
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = 0;
+    }
+
+    ReducedProblem reduced;
+    fix_variables(items, n, capacity, &reduced);
+    solve_reduced(&reduced, n, max_value, best_items, best_count,
+                  [&](Item* free_items, int free_count, float free_capacity,
+                      float* value, Item** chosen, int* chosen_count) {
+                      solver(free_items, free_count, free_capacity, value, chosen,
+                             chosen_count, nodes_explored_out, nodes_pruned_out, options);
+                  });
+}
@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "subset_sum.h"
+#include "dynamic_programming.h"
+#include "output_display.h"
+
+namespace {
+
+/**
+ * Records which item first reached each sum.
+ *
+ * When item i sets bit s of the reachable set for the first time, sum s - w_i
+ * was already reachable from items before i, so following first[] back from
+ * any sum yields a subset of distinct items. One int per sum replaces the
+ * n x C table a plain DP would need for recovery.
+ */
+struct SumRecorder {
+    int32_t* first;   // first[s] = item that first reached sum s
+    int64_t capacity; // Sums above capacity are not recorded
+    int32_t item;     // Item being added
+
+    // Marks the newly reached sums in word j of the bitset
+    inline void record(int64_t j, uint64_t bits) {
+        int64_t base = j * 64;
+        while (bits) {
+            int64_t s = base + __builtin_ctzll(bits);
+            if (s > capacity) {
+                break;
+            }
+            first[s] = item;
+            bits &= bits - 1;
+        }
+    }
+};
+
+// Word j of the bitset shifted left by q words and r bits
+inline uint64_t shifted_word(const uint64_t* set, int64_t j, int64_t q, int r) {
+    uint64_t word = set[j - q] << r;
+    if (r != 0 && j - q - 1 >= 0) {
+        word |= set[j - q - 1] >> (64 - r);
+    }
+    return word;
+}
+
+// set |= set << (q * 64 + r) over destination words [lo, hi], recording new
+// sums. Words are processed from high to low so the update can run in place
+typedef void (*ShiftOrKernel)(uint64_t* set, int64_t lo, int64_t hi,
+                              int64_t q, int r, SumRecorder& recorder);
+
+void shift_or_scalar(uint64_t* set, int64_t lo, int64_t hi,
+                     int64_t q, int r, SumRecorder& recorder) {
+    for (int64_t j = hi; j >= lo; j--) {
+        uint64_t fresh = shifted_word(set, j, q, r) & ~set[j];
+        if (fresh) {
+            set[j] |= fresh;
+            recorder.record(j, fresh);
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// AVX2: four words per step. A block only reads words at or below its own,
+// and those are not yet written when going from high to low
+__attribute__((target("avx2")))
+void shift_or_avx2(uint64_t* set, int64_t lo, int64_t hi,
+                   int64_t q, int r, SumRecorder& recorder) {
+    __m128i left = _mm_cvtsi32_si128(r);
+    __m128i right = _mm_cvtsi32_si128(64 - r);  // Count 64 shifts to zero
+    int64_t j = hi;
+    // Vector blocks [j - 3, j] whose source words j - q - 4 .. j - q exist
+    for (; j - 3 >= lo && j - 3 - q - 1 >= 0; j -= 4) {
+        __m256i low = _mm256_loadu_si256((const __m256i*)(set + j - 3 - q));
+        __m256i carry = _mm256_loadu_si256((const __m256i*)(set + j - 3 - q - 1));
+        __m256i old = _mm256_loadu_si256((const __m256i*)(set + j - 3));
+        __m256i shifted = _mm256_or_si256(_mm256_sll_epi64(low, left),
+                                          _mm256_srl_epi64(carry, right));
+        __m256i fresh = _mm256_andnot_si256(old, shifted);
+        if (!_mm256_testz_si256(fresh, fresh)) {
+            _mm256_storeu_si256((__m256i*)(set + j - 3), _mm256_or_si256(old, fresh));
+            uint64_t words[4];
+            _mm256_storeu_si256((__m256i*)words, fresh);
+            for (int k = 3; k >= 0; k--) {
+                if (words[k]) {
+                    recorder.record(j - 3 + k, words[k]);
+                }
+            }
+        }
+    }
+    shift_or_scalar(set, lo, j, q, r, recorder);
+}
+
+// AVX-512: eight words per step, same scheme as the AVX2 kernel. The
+// zero-masked forms with every lane selected compile to the plain
+// instructions; the unmasked ones pass GCC an undefined source vector,
+// which it reports as possibly uninitialized
+__attribute__((target("avx512f")))
+void shift_or_avx512(uint64_t* set, int64_t lo, int64_t hi,
+                     int64_t q, int r, SumRecorder& recorder) {
+    const __mmask8 all = 0xFF;
+    __m128i left = _mm_cvtsi32_si128(r);
+    __m128i right = _mm_cvtsi32_si128(64 - r);
+    int64_t j = hi;
+    for (; j - 7 >= lo && j - 7 - q - 1 >= 0; j -= 8) {
+        __m512i low = _mm512_loadu_si512((const void*)(set + j - 7 - q));
+        __m512i carry = _mm512_loadu_si512((const void*)(set + j - 7 - q - 1));
+        __m512i old = _mm512_loadu_si512((const void*)(set + j - 7));
+        __m512i shifted = _mm512_or_si512(_mm512_maskz_sll_epi64(all, low, left),
+                                          _mm512_maskz_srl_epi64(all, carry, right));
+        __m512i fresh = _mm512_maskz_andnot_epi64(all, old, shifted);
+        __mmask8 nonzero = _mm512_test_epi64_mask(fresh, fresh);
+        if (nonzero) {
+            _mm512_storeu_si512((void*)(set + j - 7), _mm512_or_si512(old, fresh));
+            uint64_t words[8];
+            _mm512_storeu_si512((void*)words, fresh);
+            for (int k = 7; k >= 0; k--) {
+                if (nonzero & (1u << k)) {
+                    recorder.record(j - 7 + k, words[k]);
+                }
+            }
+        }
+    }
+    shift_or_scalar(set, lo, j, q, r, recorder);
+}
+#endif
+
+// Bytes of the reachable bitset and the first-item array over capacity
+double table_bytes(int64_t capacity) {
+    return (double)(capacity / 64 + 1) * sizeof(uint64_t) +
+           (double)(capacity + 1) * sizeof(int32_t);
+}
+
+ShiftOrKernel select_kernel(const char** name) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx512f")) {
+        *name = "AVX-512";
+        return shift_or_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "AVX2";
+        return shift_or_avx2;
+    }
+#endif
+    *name = "scalar";
+    return shift_or_scalar;
+}
+
+} // namespace
+
+bool is_subset_sum(const Item* items, int n) {
+    for (int i = 0; i < n; i++) {
+        if (items[i].value != items[i].weight) {
+            return false;
+        }
+    }
+    return n > 0;
+}
+
+/**
+ * Bitset subset-sum solver for 0/1 Knapsack instances with value == weight.
+ *
+ * With every ratio equal to 1 the fractional bound is the capacity itself,
+ * so branch and bound can prune almost nothing. Here weights are scaled to
+ * exact integers and bit s of a (capacity + 1)-bit set marks sum s as
+ * reachable; adding an item with weight w is set |= set << w, which costs
+ * capacity / 64 word operations (a quarter or an eighth of that with AVX2 or
+ * AVX-512, selected at run time). The optimum is the highest reachable sum,
+ * and the subset is read back from the item that first reached each sum.
+ *
+ * @param items Array of available items
+ * @param n Number of items
+ * @param capacity Maximum knapsack capacity
+ * @param max_value Output: optimal value achieved
+ * @param best_items Output: array of selected items
+ * @param best_count Output: number of selected items
+ * @param options Optional settings, passed on to the fallback engines
+ */
+void subset_sum(Item* items, int n, float capacity,
+                float* max_value, Item** best_items,
+                int* best_count,
+                int* nodes_explored_out, int* nodes_pruned_out,
+                const SearchOptions* options) {
+    ScaledInstance instance;
+    if (!is_subset_sum(items, n) ||
+        !scale_instance(items, n, capacity, &instance) ||
+        table_bytes(instance.capacity) > DP_MAX_BYTES) {
+        print_info("Not a subset-sum instance or capacity too large; using dynamic programming\n");
+        dynamic_programming(items, n, capacity, max_value, best_items, best_count,
+                            nodes_explored_out, nodes_pruned_out, options);
+        return;
+    }
+
+    const char* kernel_name = nullptr;
+    ShiftOrKernel kernel = select_kernel(&kernel_name);
+    int64_t cap = instance.capacity;
+    print_info("Subset sum: scale %lld, %lld-bit set, %s kernel\n",
+               (long long)instance.scale, (long long)(cap + 1), kernel_name);
+
+    int64_t words = cap / 64 + 1;
+    uint64_t last_mask = (cap % 64 == 63) ? ~0ULL : ((1ULL << (cap % 64 + 1)) - 1);
+    std::vector<uint64_t> reachable(words, 0);
+    std::vector<int32_t> first(cap + 1, -1);
+    reachable[0] = 1;  // The empty subset
+
+    SumRecorder recorder;
+    recorder.first = first.data();
+    recorder.capacity = cap;
+
+    // Upper bound on the reachable sums: words above it are still zero
+    int64_t reach = 0;
+    bool full = false;
+    for (int i = 0; i < n && !full; i++) {
+        int64_t w = instance.weight[i];
+        if (w == 0 || w > cap) {
+            continue;
+        }
+        recorder.item = i;
+        int64_t hi = std::min(cap, reach + w) / 64;
+        kernel(reachable.data(), w / 64, hi, w / 64, (int)(w % 64), recorder);
+        reachable[words - 1] &= last_mask;
+        reach = std::min(cap, reach + w);
+        // Once the capacity itself is reachable nothing can do better
+        full = (reachable[cap / 64] >> (cap % 64)) & 1;
+    }
+
+    // Largest reachable sum that fits
+    int64_t best = 0;
+    for (int64_t j = words - 1; j >= 0; j--) {
+        if (reachable[j]) {
+            best = j * 64 + 63 - __builtin_clzll(reachable[j]);
+            break;
+        }
+    }
+
+    std::vector<char> take(n, 0);
+    for (int64_t s = best; s > 0; s -= instance.weight[first[s]]) {
+        take[first[s]] = 1;
+    }
+
+    *best_items = new Item[n];
+    *best_count = 0;
+    *max_value = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (take[i]) {
+            (*best_items)[(*best_count)++] = items[i];
+            *max_value += items[i].value;
+        }
+    }
+
+    if (nodes_explored_out) {
+        *nodes_explored_out = 0;
+    }
+    if (nodes_pruned_out) {
+        *nodes_pruned_out = 0;
+    }
+}